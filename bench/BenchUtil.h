@@ -0,0 +1,87 @@
+#ifndef OPENGLPRJ_BENCHUTIL_H
+#define OPENGLPRJ_BENCHUTIL_H
+#include <chrono>
+#include <random>
+#include <vector>
+#include "Grid.h"
+
+// wall clock timer used by all benchmarks
+class Timer {
+private:
+    std::chrono::steady_clock::time_point start;
+
+public:
+    Timer() : start(std::chrono::steady_clock::now()) {}
+
+    void reset() {
+        start = std::chrono::steady_clock::now();
+    }
+
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// keeps the compiler from optimizing away results that are never used
+static volatile long long benchSink = 0;
+
+// grid of any size for benchmarks with its own seed, independent of the Maze globals
+// perfect maze from a randomized depth-first search, then loopPercent of the cells get one extra opening
+inline Grid makeGrid(int rows, int cols, unsigned int seed, int loopPercent = 30) {
+    Grid grid(rows, cols);
+    for(int i=0; i<rows; i++) {
+        for(int j=0; j<cols; j++) {
+            grid[i][j].closeAll();
+        }
+    }
+
+    std::mt19937 rng(seed);
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = {0, 0, -1, 1};
+
+    // opens the wall between (r, c) and its neighbor in direction d
+    struct Opener {
+        static void open(Grid &grid, int r, int c, int d) {
+            if(d == 0) { grid[r][c].setWallUp(false); grid[r-1][c].setWallDown(false); }
+            if(d == 1) { grid[r][c].setWallDown(false); grid[r+1][c].setWallUp(false); }
+            if(d == 2) { grid[r][c].setWallLeft(false); grid[r][c-1].setWallRight(false); }
+            if(d == 3) { grid[r][c].setWallRight(false); grid[r][c+1].setWallLeft(false); }
+        }
+    };
+
+    std::vector<int> stack;
+    stack.push_back(0);
+    grid[0][0].setVisited(true);
+    while(!stack.empty()) {
+        int r = stack.back() / cols, c = stack.back() % cols;
+        int options[4], count = 0;
+        for(int d=0; d<4; d++) {
+            int nr = r + dr[d], nc = c + dc[d];
+            if(nr >= 0 && nr < rows && nc >= 0 && nc < cols && !grid[nr][nc].isVisited())
+                options[count++] = d;
+        }
+        if(count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        int d = options[rng() % count];
+        Opener::open(grid, r, c, d);
+        grid[r + dr[d]][c + dc[d]].setVisited(true);
+        stack.push_back((r + dr[d]) * cols + c + dc[d]);
+    }
+
+    for(int i=0; i<rows; i++) {
+        for(int j=0; j<cols; j++) {
+            grid[i][j].setVisited(false);
+            if((int)(rng() % 100) < loopPercent) {
+                int d = rng() % 4;
+                int nr = i + dr[d], nc = j + dc[d];
+                if(nr >= 0 && nr < rows && nc >= 0 && nc < cols)
+                    Opener::open(grid, i, j, d);
+            }
+        }
+    }
+    return grid;
+}
+
+#endif // OPENGLPRJ_BENCHUTIL_H
@@ -0,0 +1,71 @@
+// A* with landmark (ALT) heuristics: preprocessing, memory, heuristic quality and query time for different landmark counts
+#include <cstdio>
+#include <cstdlib>
+#include "Bfs.h"
+#include "AStar.h"
+#include "BenchUtil.h"
+
+int main(int argc, char* argv[]) {
+    int size = argc > 1 ? atoi(argv[1]) : 1000;
+    const int queries = 200;
+    int failures = 0;
+
+    printf("maze %dx%d, %d queries\n", size, size, queries);
+    for(int loopPercent : {0, 30}) {
+        Grid grid = makeGrid(size, size, 17, loopPercent);
+        NavGraph graph;
+        graph.build(grid);
+        int V = graph.getV();
+
+        BFS bfs(graph);
+        vector<int> sources(queries), dests(queries), expected(queries);
+        vector<int> path;
+        srand(loopPercent + 5);
+        for(int i=0; i<queries; i++) {
+            sources[i] = rand() % V;
+            dests[i] = rand() % V;
+            bfs.getPath(sources[i], dests[i], path);
+            expected[i] = path.size();
+        }
+
+        printf("\n%d%% loops\n", loopPercent);
+        printf("%10s %12s %10s %12s %14s %12s %10s\n", "landmarks", "build ms", "MB", "h / dist", "expanded", "us/query", "vs A*");
+        double astarUs = 0;
+        for(int count : {0, 1, 2, 4, 8, 16}) {
+            Timer timer;
+            Landmarks landmarks(graph, count);
+            double buildMs = timer.elapsedMs();
+            AStar astar(graph, count > 0 ? &landmarks : nullptr);
+
+            // how much of the real distance the heuristic sees at the source
+            double ratio = 0;
+            int measured = 0;
+            for(int i=0; i<queries; i++) {
+                if(expected[i] > 0) {
+                    ratio += (double)astar.estimate(sources[i], dests[i]) / expected[i];
+                    measured++;
+                }
+            }
+
+            long long expanded = 0;
+            timer.reset();
+            for(int i=0; i<queries; i++) {
+                astar.getPath(sources[i], dests[i], path);
+                expanded += astar.getExpanded();
+                if((int)path.size() != expected[i])
+                    failures++;
+            }
+            double us = timer.elapsedMs() * 1000 / queries;
+            if(count == 0)
+                astarUs = us;
+            printf("%10d %12.1f %10.1f %12.3f %14lld %12.1f %9.1fx\n", count, buildMs, landmarks.getMemoryBytes() / 1048576.0,
+                   ratio / measured, expanded / queries, us, astarUs / us);
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d ALT paths have a different length than BFS\n", failures);
+        return 1;
+    }
+    return 0;
+}
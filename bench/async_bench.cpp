@@ -0,0 +1,179 @@
+// ghosts chasing pacman with their searches on worker threads, driven through Ghost::move() like the render loop
+// a frame is the ghost work on the main thread followed by a sleep until the next 60 Hz tick, like the render loop with vsync
+// an ALT service builds its landmarks on a worker, its ghosts get plain A* paths until they are done
+// reports the main thread time per frame, what became of the ghosts' requests and how often a ghost stood still without a path
+// every step is checked after the frames: it has to go to a neighboring cell and most steps have to get closer to pacman
+// the program fails if a step isn't legal, a request is unaccounted for also after the ghosts are reset, or the ghosts drop results or wait more than they should
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "Ghost.h"
+#include "BenchUtil.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *name, const char *what) {
+    if(!ok) {
+        printf("ERROR: %s: %s\n", name, what);
+        failures++;
+    }
+}
+
+static bool isNeighbor(const NavGraph &graph, int a, int b) {
+    for(int k : graph.neighborsOf(a))
+        if(k == b)
+            return true;
+    return false;
+}
+
+// a ghost went from one cell to the next while pacman was on dest
+struct Step {
+    int from;
+    int to;
+    int dest;
+};
+
+static void runCase(int size, int loopPercent, int ghostCount, PathEngine engine) {
+    const int frames = 600;
+    const float deltaTime = 1.0f / 60;
+
+    Grid grid = makeGrid(size, size, 31, loopPercent);
+    NavGraph graph;
+    graph.build(grid);
+    int V = graph.getV();
+    rows = cols = size;
+
+    // pacman moves one cell every 6 frames, ghosts one cell every 4
+    vector<int> pacmanWalk(frames);
+    srand(size + loopPercent);
+    int pacman = rand() % V;
+    long long pacmanMoves = 0;
+    for(int f=0; f<frames; f++) {
+        if(f % 6 == 0) {
+            NavGraph::Neighbors neighbors = graph.neighborsOf(pacman);
+            pacman = neighbors.begin()[rand() % neighbors.size()];
+            pacmanMoves++;
+        }
+        pacmanWalk[f] = pacman;
+    }
+
+    Navigation navigation;
+    navigation.build(graph);
+    vector<Ghost> ghosts;
+    ghosts.reserve(ghostCount);
+    for(int g=0; g<ghostCount; g++) {
+        int cell = rand() % V;
+        ghosts.emplace_back(glm::vec3(cell % cols, 0.0f, cell / cols), navigation, engine);
+        ghosts.back().moveSpeed = 15.0f;
+    }
+    vector<int> cells(ghostCount);
+    for(int g=0; g<ghostCount; g++)
+        cells[g] = ghosts[g].getCell();
+
+    // the steps are checked after the frames, the check would take the time of the workers on a machine with few cores
+    vector<Step> steps;
+    steps.reserve(frames * ghostCount);
+    double totalMs = 0, maxMs = 0;
+    long long waiting = 0;
+    Timer clock;
+    for(int f=0; f<frames; f++) {
+        int dest = pacmanWalk[f];
+
+        Timer timer;
+        // the fields are only asked for when a ghost reads them, a field nobody reads would take the time of the path workers
+        if(engine == ENGINE_FLOW_FIELD)
+            navigation.updateTarget(dest, false);
+        for(Ghost &ghost : ghosts)
+            ghost.move(deltaTime, dest);
+        double ms = timer.elapsedMs();
+        totalMs += ms;
+        if(ms > maxMs)
+            maxMs = ms;
+
+        for(int g=0; g<ghostCount; g++) {
+            int cell = ghosts[g].getCell();
+            if(cell != cells[g]) {
+                Step step = {cells[g], cell, dest};
+                steps.push_back(step);
+                cells[g] = cell;
+            }
+            if(ghosts[g].getNextCell() == -1 && cell != dest)
+                waiting++;
+        }
+
+        double wait = (f + 1) * deltaTime * 1000 - clock.elapsedMs();
+        if(wait > 0)
+            this_thread::sleep_for(chrono::microseconds((long long)(wait * 1000)));
+    }
+
+    // pacman only moves to neighboring cells, so the field follows the steps with repairs
+    FlowField distances(graph);
+    long long closer = 0, illegal = 0;
+    for(const Step &step : steps) {
+        distances.update(step.dest);
+        if(!isNeighbor(graph, step.from, step.to))
+            illegal++;
+        if(distances.getDistance(step.to) < distances.getDistance(step.from))
+            closer++;
+    }
+
+    // the flow field has no tickets, a dropped field is its stale result
+    long long requests, taken, stale;
+    const PathServiceStats &stats = navigation.pathServiceStats;
+    if(engine == ENGINE_FLOW_FIELD) {
+        FieldService &fields = navigation.getFieldService();
+        taken = fields.getPublishes();
+        stale = fields.getDrops();
+        requests = taken + stale;
+    }else{
+        requests = stats.requests;
+        taken = stats.taken;
+        stale = stats.stale;
+    }
+
+    char name[16];
+    snprintf(name, sizeof(name), "%dx%d", size, size);
+    const char *engineName = engine == ENGINE_FLOW_FIELD ? "flow" : navigation.getEngine(engine).getName();
+    printf("%-10s %5d%% %7d %-14s %10.3f %10.3f %9lld %9lld %9lld %9lld %9lld %9lld %9lld %9lld %8.1f%%\n", name, loopPercent,
+           ghostCount, engineName, totalMs / frames, maxMs, requests, taken, stale, stats.missed, stats.cancelled, stats.retargeted,
+           stats.lost, waiting, steps.empty() ? 0.0 : 100.0 * closer / steps.size());
+
+    char label[48];
+    snprintf(label, sizeof(label), "%s %d%% %s", name, loopPercent, engineName);
+    check(illegal == 0, label, "a ghost stepped to a cell that isn't its neighbor");
+    // every request ends once, a ghost has at most one waiting
+    check(stats.requests - stats.getFinished() >= 0 && stats.requests - stats.getFinished() <= ghostCount, label,
+          "requests unaccounted for");
+    // a result is only dropped when pacman moved after it was asked for, and a ghost waits for one request at a time,
+    // so a move of pacman makes at most one result per ghost stale, the field worker drops at most one field per move
+    check(taken > 0 && stale <= pacmanMoves * (engine == ENGINE_FLOW_FIELD ? 1 : ghostCount), label,
+          "results were dropped more often than pacman moved");
+    // a ghost only stands still until its first path is ready and when it walks the old path to its end before the new one,
+    // one ghost frame in ten is far more than that
+    check(waiting * 10 <= (long long)frames * ghostCount, label, "ghosts waited for paths too often");
+    // the path to pacman's previous cell is walked until the new one is ready, it goes the wrong way for a step or two
+    check(!steps.empty() && closer * 10 >= (long long)steps.size() * 7, label, "too few steps get closer to pacman");
+
+    // ghosts are reset like at the start of a round, the request each one was waiting for is cancelled
+    for(Ghost &ghost : ghosts)
+        ghost.cancelSearch();
+    check(stats.requests == stats.getFinished(), label, "a reset ghost left its request unaccounted for");
+}
+
+int main() {
+    printf("%-10s %6s %7s %-14s %10s %10s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "maze", "loops", "ghosts", "engine", "frame ms",
+           "max ms", "requests", "taken", "stale", "missed", "cancelled", "retarget", "lost", "waiting", "closer");
+    runCase(200, 30, 8, ENGINE_BFS);
+    runCase(1000, 30, 8, ENGINE_BFS);
+    runCase(1000, 30, 8, ENGINE_ASTAR);
+    runCase(1000, 30, 8, ENGINE_ALT);
+    runCase(1000, 30, 8, ENGINE_CORRIDOR);
+    runCase(1000, 0, 8, ENGINE_BFS);
+    runCase(1000, 30, 8, ENGINE_FLOW_FIELD);
+
+    if(failures != 0) {
+        printf("ERROR: %d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
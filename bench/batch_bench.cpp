@@ -0,0 +1,76 @@
+// next cells for a swarm of ghosts: one BFS per ghost against one batched BFS from the target
+#include <cstdio>
+#include <cstdlib>
+#include "Bfs.h"
+#include "BenchUtil.h"
+
+int main() {
+    int failures = 0;
+
+    printf("%-10s %8s %16s %16s %10s\n", "maze", "ghosts", "per ghost us", "batched us", "speedup");
+    for(int size : {10, 100, 500}) {
+        Grid grid = makeGrid(size, size, 19, 30);
+        NavGraph graph;
+        graph.build(grid);
+        int V = graph.getV();
+        BFS bfs(graph);
+        int rounds = size == 10 ? 2000 : (size == 100 ? 50 : 3);
+        char name[16];
+        snprintf(name, sizeof(name), "%dx%d", size, size);
+
+        for(int ghosts : {4, 64, 1024}) {
+            vector<int> sources(ghosts), next(ghosts), targets(rounds);
+            vector<vector<int> > swarms(rounds, vector<int>(ghosts));
+            srand(size + ghosts);
+            for(int r=0; r<rounds; r++) {
+                targets[r] = rand() % V;
+                for(int g=0; g<ghosts; g++)
+                    swarms[r][g] = rand() % V;
+            }
+
+            vector<int> path;
+            Timer timer;
+            for(int r=0; r<rounds; r++) {
+                for(int g=0; g<ghosts; g++) {
+                    bfs.getPath(swarms[r][g], targets[r], path);
+                    benchSink += path.empty() ? -1 : path[0];
+                }
+            }
+            double singleUs = timer.elapsedMs() * 1000 / rounds;
+
+            timer.reset();
+            for(int r=0; r<rounds; r++) {
+                bfs.getNextCells(swarms[r].data(), ghosts, targets[r], next.data());
+                benchSink += next[0];
+            }
+            double batchUs = timer.elapsedMs() * 1000 / rounds;
+            printf("%-10s %8d %16.1f %16.1f %9.1fx\n", name, ghosts, singleUs, batchUs, singleUs / batchUs);
+
+            // a next cell has to be a neighbor one step closer to the target
+            for(int r=0; r<3; r++) {
+                bfs.getNextCells(swarms[r].data(), ghosts, targets[r], next.data());
+                for(int g=0; g<ghosts && g<64; g++) {
+                    int source = swarms[r][g];
+                    bfs.getPath(source, targets[r], path);
+                    int length = path.size();
+                    if(source == targets[r] || length == 0) {
+                        failures += next[g] != -1;
+                        continue;
+                    }
+                    bool adjacent = false;
+                    for(int k : graph.neighborsOf(source))
+                        adjacent |= k == next[g];
+                    bfs.getPath(next[g], targets[r], path);
+                    if(!adjacent || (int)path.size() != length - 1)
+                        failures++;
+                }
+            }
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d next cells are not on a shortest path\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+// measures the BFS workspace against the original per-query allocations
+// and counts heap allocations while ghosts move in steady state
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <queue>
+#include <atomic>
+#include "Ghost.h"
+#include "BenchUtil.h"
+
+// every allocation made by the program goes through here, the plain, array and sized forms all use malloc and free
+// the calls to malloc and free are kept out of line, gcc would otherwise see free called on the result of operator new
+static atomic<long long> allocations(0);
+
+#ifdef _MSC_VER
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+BENCH_NOINLINE static void* countedAlloc(size_t size) {
+    allocations++;
+    void* p = malloc(size == 0 ? 1 : size);
+    if(p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+BENCH_NOINLINE static void countedFree(void* p) noexcept {
+    free(p);
+}
+
+void* operator new(size_t size) {
+    return countedAlloc(size);
+}
+
+void* operator new[](size_t size) {
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+    countedFree(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    countedFree(p);
+}
+
+// the path query as it was before the workspace: new arrays cleared per search and a path built with insert
+vector<int> legacyGetPath(const NavGraph &graph, int source, int dest) {
+    int V = graph.getV();
+    int* parent = new int[V];
+    bool* visited = new bool[V];
+    vector<int> path;
+    for(int i=0; i<V; i++) {
+        visited[i] = false;
+        parent[i] = -1;
+    }
+    queue<int> q;
+    q.push(source);
+    visited[source] = true;
+    bool found = false;
+    while(!q.empty() && !found) {
+        int temp = q.front();
+        q.pop();
+        for(int k: graph.neighborsOf(temp)) {
+            if(!visited[k]) {
+                q.push(k);
+                visited[k] = true;
+                parent[k] = temp;
+                if(k == dest) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+    if(found) {
+        while(parent[dest] != -1) {
+            path.insert(path.begin(), dest);
+            dest = parent[dest];
+        }
+    }
+    delete[] parent;
+    delete[] visited;
+    return path;
+}
+
+int main() {
+    const int queries = 200000;
+    int failures = 0;
+
+    srand(1);
+    Maze mazeClass(rows, cols, 1);
+    mazeClass.generateMaze();
+    BFS algorithm(mazeClass.graph);
+
+    vector<int> sources(queries), dests(queries);
+    for(int i=0; i<queries; i++) {
+        sources[i] = rand() % (rows*cols);
+        dests[i] = rand() % (rows*cols);
+    }
+
+    // path queries
+    Timer timer;
+    long long before = allocations;
+    for(int i=0; i<queries; i++)
+        benchSink += legacyGetPath(mazeClass.graph, sources[i], dests[i]).size();
+    double legacyMs = timer.elapsedMs();
+    long long legacyAllocations = allocations - before;
+
+    vector<int> path;
+    algorithm.getPath(0, rows*cols - 1, path);
+    timer.reset();
+    before = allocations;
+    for(int i=0; i<queries; i++) {
+        algorithm.getPath(sources[i], dests[i], path);
+        benchSink += path.size();
+    }
+    double workspaceMs = timer.elapsedMs();
+    long long workspaceAllocations = allocations - before;
+
+    printf("maze %dx%d, %d path queries\n\n", rows, cols, queries);
+    printf("%12s %12s %16s\n", "", "ns/query", "allocs/query");
+    printf("%12s %12.1f %16.2f\n", "legacy", legacyMs * 1e6 / queries, (double)legacyAllocations / queries);
+    printf("%12s %12.1f %16.2f\n", "workspace", workspaceMs * 1e6 / queries, (double)workspaceAllocations / queries);
+
+    for(int i=0; i<1000; i++) {
+        vector<int> expected = legacyGetPath(mazeClass.graph, sources[i], dests[i]);
+        algorithm.getPath(sources[i], dests[i], path);
+        if(path != expected)
+            failures++;
+    }
+
+    // ghosts chasing a moving target, first with every ghost step answered by a batched BFS query from the target,
+    // then the same way as in the game loop with the flow field, the navigation table isn't used by either
+    Navigation navigation;
+    navigation.build(mazeClass.graph);
+    const float deltaTime = 1.0f / 60.0f;
+    const int warmupFrames = 60 * 600;
+    const int frames = 60 * 600;
+    long long movementAllocations[2];
+    long long bfsSteps = 0;
+    for(int run=0; run<2; run++) {
+        bool useField = run == 1;
+        Ghost ghosts[4] = {
+                Ghost(glm::vec3(0.0f, 0.0f, 0.0f), navigation),
+                Ghost(glm::vec3(cols-1, 0.0f, rows-1), navigation),
+                Ghost(glm::vec3(cols-1, 0.0f, 0.0f), navigation),
+                Ghost(glm::vec3(0.0f, 0.0f, rows-1), navigation)
+        };
+        int target = rand() % (rows*cols);
+        for(int f=0; f<warmupFrames + frames; f++) {
+            if(f == warmupFrames)
+                before = allocations;
+            if(f % 30 == 0)
+                target = rand() % (rows*cols);
+            if(useField) {
+                navigation.updateTarget(target, false);
+                for(Ghost &ghost : ghosts)
+                    ghost.move(deltaTime, target);
+                continue;
+            }
+            Ghost* waiting[4];
+            int sources[4], next[4], count = 0;
+            for(Ghost &ghost : ghosts) {
+                if(!ghost.advance(deltaTime))
+                    continue;
+                waiting[count] = &ghost;
+                sources[count++] = ghost.getCell();
+            }
+            navigation.bfs.getNextCells(sources, count, target, next);
+            for(int i=0; i<count; i++)
+                waiting[i]->setNextCell(next[i]);
+            if(f >= warmupFrames)
+                bfsSteps += count;
+        }
+        movementAllocations[run] = allocations - before;
+    }
+    printf("\nsteady state ghost movement, %d frames:\n", frames);
+    printf("%12s %12lld allocations in %lld ghost steps\n", "BFS", movementAllocations[0], bfsSteps);
+    printf("%12s %12lld allocations\n", "flow field", movementAllocations[1]);
+
+    if(failures != 0)
+        printf("ERROR: %d paths differ from the legacy BFS\n", failures);
+    if(workspaceAllocations != 0)
+        printf("ERROR: path queries allocated\n");
+    if(movementAllocations[0] != 0 || movementAllocations[1] != 0)
+        printf("ERROR: ghost movement allocated in steady state\n");
+    if(bfsSteps == 0)
+        printf("ERROR: the BFS run made no queries\n");
+    return failures == 0 && workspaceAllocations == 0 && movementAllocations[0] == 0 && movementAllocations[1] == 0 && bfsSteps != 0 ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+// checks the bitboard BFS against BFS::getPath and compares their speed
+#include <cstdio>
+#include <cstdlib>
+#include "Maze.h"
+#include "Bfs.h"
+#include "BitboardBFS.h"
+#include "FlowField.h"
+#include "BenchUtil.h"
+
+// is path a walk through open passages from source to dest
+static bool isValidPath(const NavGraph &graph, int source, int dest, const vector<int> &path) {
+    int v = source;
+    for(int k : path) {
+        bool connected = false;
+        for(int n : graph.neighborsOf(v))
+            if(n == k)
+                connected = true;
+        if(!connected)
+            return false;
+        v = k;
+    }
+    return v == dest;
+}
+
+// compares both engines on random pairs and full distance fields, returns the number of mismatches
+static int crossCheck(const NavGraph &graph, int pairs) {
+    BFS bfs(graph);
+    BitboardBFS bitboard(graph);
+    int V = graph.getV();
+    int failures = 0;
+    vector<int> expected, path;
+
+    for(int i=0; i<pairs; i++) {
+        int source = rand() % V, dest = rand() % V;
+        bfs.getPath(source, dest, expected);
+        bitboard.getPath(source, dest, path);
+        if(path.size() != expected.size() || (!path.empty() && !isValidPath(graph, source, dest, path)))
+            failures++;
+    }
+
+    FlowField field(graph);
+    for(int i=0; i<3; i++) {
+        int source = rand() % V;
+        field.update(source);
+        bitboard.computeDistances(source);
+        for(int v=0; v<V; v++)
+            if(field.getDistance(v) != bitboard.getDistance(v))
+                failures++;
+    }
+    return failures;
+}
+
+int main() {
+    int failures = 0;
+
+#ifdef __AVX2__
+    printf("bitboard word loop: AVX2\n\n");
+#else
+    printf("bitboard word loop: 64 bit scalar\n\n");
+#endif
+
+    // the game maze
+    for(int m=0; m<50; m++) {
+        srand(m);
+        Maze mazeClass(rows, cols, m);
+        mazeClass.generateMaze();
+        failures += crossCheck(mazeClass.graph, 200);
+    }
+
+    // maze with the game's loop density, then an open arena where the whole frontier shares words
+    printf("%16s %14s %18s %14s %18s\n", "maze", "BFS path ms", "bitboard path ms", "BFS field ms", "bitboard field ms");
+    const int sizes[] = {10, 100, 500, 1000, 2000};
+    for(int open = 0; open < 2; open++)
+    for(int size : sizes) {
+        Grid grid = makeGrid(size, size, size);
+        if(open) {
+            for(int i=0; i<size; i++) {
+                for(int j=0; j<size; j++) {
+                    grid[i][j].setWallUp(i == 0);
+                    grid[i][j].setWallDown(i == size-1);
+                    grid[i][j].setWallLeft(j == 0);
+                    grid[i][j].setWallRight(j == size-1);
+                }
+            }
+        }
+        NavGraph graph;
+        graph.build(grid);
+        int V = graph.getV();
+        srand(size);
+        failures += crossCheck(graph, size <= 500 ? 200 : 20);
+
+        BFS bfs(graph);
+        BitboardBFS bitboard(graph);
+        FlowField field(graph);
+        vector<int> path;
+        const int queries = size <= 100 ? 1000 : 20;
+        vector<int> sources(queries), dests(queries);
+        for(int i=0; i<queries; i++) {
+            sources[i] = rand() % V;
+            dests[i] = rand() % V;
+        }
+
+        Timer timer;
+        for(int i=0; i<queries; i++) {
+            bfs.getPath(sources[i], dests[i], path);
+            benchSink += path.size();
+        }
+        double bfsPathMs = timer.elapsedMs() / queries;
+
+        timer.reset();
+        for(int i=0; i<queries; i++) {
+            bitboard.getPath(sources[i], dests[i], path);
+            benchSink += path.size();
+        }
+        double bitboardPathMs = timer.elapsedMs() / queries;
+
+        // full distance fields, the flow field is a plain BFS from its target
+        timer.reset();
+        for(int i=0; i<queries; i++) {
+            field.update(sources[i]);
+            benchSink += field.getDistance(dests[i]);
+        }
+        double bfsFieldMs = timer.elapsedMs() / queries;
+
+        timer.reset();
+        for(int i=0; i<queries; i++) {
+            bitboard.computeDistances(sources[i]);
+            benchSink += bitboard.getDistance(dests[i]);
+        }
+        double bitboardFieldMs = timer.elapsedMs() / queries;
+
+        char name[32];
+        snprintf(name, sizeof(name), "%s %dx%d", open ? "arena" : "maze", size, size);
+        printf("%16s %14.4f %18.4f %14.4f %18.4f\n", name, bfsPathMs, bitboardPathMs, bfsFieldMs, bitboardFieldMs);
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d results differ from BFS\n", failures);
+        return 1;
+    }
+    printf("\ncross-check against BFS passed\n");
+    return 0;
+}
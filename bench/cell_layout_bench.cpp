@@ -0,0 +1,80 @@
+// memory and scan speed of the packed one byte cells against the old layout (row, col and seven bools in a vector per row)
+// both grids hold the same maze, the program fails if a scan or the navigation graph differs between them
+#include <cstdio>
+#include <vector>
+#include "NavGraph.h"
+#include "BenchUtil.h"
+
+// the cell as it was before it was packed
+struct LegacyCell {
+    int row, col;
+    bool wallUp, wallDown, wallLeft, wallRight, hasCoin, hasPowerup, visited;
+};
+
+int main() {
+    int failures = 0;
+    printf("%-10s %12s %12s %14s %14s %14s\n", "maze", "legacy MB", "packed MB", "legacy scan ms", "packed scan ms", "graph build ms");
+    for(int size : {100, 1000, 4096}) {
+        Grid grid = makeGrid(size, size, 41, 30);
+        for(int i=0; i<size; i++)
+            for(int j=0; j<size; j++)
+                grid[i][j].setCoin((i + j) % 3 != 0);
+
+        vector<vector<LegacyCell> > legacy(size, vector<LegacyCell>(size));
+        for(int i=0; i<size; i++) {
+            for(int j=0; j<size; j++) {
+                const Cell &cell = grid[i][j];
+                LegacyCell &old = legacy[i][j];
+                old.row = i;
+                old.col = j;
+                old.wallUp = cell.wallUp();
+                old.wallDown = cell.wallDown();
+                old.wallLeft = cell.wallLeft();
+                old.wallRight = cell.wallRight();
+                old.hasCoin = cell.hasCoin();
+                old.hasPowerup = cell.hasPowerup();
+                old.visited = cell.isVisited();
+            }
+        }
+        double legacyMb = (double)size * (sizeof(vector<LegacyCell>) + size * sizeof(LegacyCell)) / (1 << 20);
+        double packedMb = (double)grid.getMemoryBytes() / (1 << 20);
+
+        // count the walls drawn and the coins left, like loadWalls and loadCoinsAndPowerups do every frame
+        const int repeats = size <= 1000 ? 20 : 3;
+        long long legacyCount = 0, packedCount = 0;
+        Timer timer;
+        for(int r=0; r<repeats; r++)
+            for(int i=0; i<size; i++)
+                for(int j=0; j<size; j++)
+                    legacyCount += legacy[i][j].wallLeft + legacy[i][j].wallUp + legacy[i][j].hasCoin;
+        double legacyMs = timer.elapsedMs() / repeats;
+        timer.reset();
+        for(int r=0; r<repeats; r++)
+            for(int i=0; i<size; i++)
+                for(int j=0; j<size; j++)
+                    packedCount += grid[i][j].wallLeft() + grid[i][j].wallUp() + grid[i][j].hasCoin();
+        double packedMs = timer.elapsedMs() / repeats;
+        if(legacyCount != packedCount)
+            failures++;
+
+        timer.reset();
+        NavGraph graph;
+        graph.build(grid);
+        double buildMs = timer.elapsedMs();
+        for(int v=0; v<graph.getV(); v++) {
+            const LegacyCell &old = legacy[v / size][v % size];
+            if(graph.degree(v) != !old.wallUp + !old.wallDown + !old.wallLeft + !old.wallRight)
+                failures++;
+        }
+
+        char name[16];
+        snprintf(name, sizeof(name), "%dx%d", size, size);
+        printf("%-10s %12.1f %12.1f %14.2f %14.2f %14.1f\n", name, legacyMb, packedMb, legacyMs, packedMs, buildMs);
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d differences between the packed and the legacy cells\n", failures);
+        return 1;
+    }
+    return 0;
+}
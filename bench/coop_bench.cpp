@@ -0,0 +1,104 @@
+// many ghosts chasing pacman: every ghost following the flow field against the cooperative planner
+// reports the time per tick without the flow field update, which both share, and how many ghosts end up on a cell with another ghost
+#include <cstdio>
+#include <cstdlib>
+#include "CooperativePlanner.h"
+#include "BenchUtil.h"
+
+// ghosts that share their cell with another ghost, pacman's cell doesn't count
+static int countStacked(const vector<int> &cells, vector<int> &count, int pacman) {
+    int stacked = 0;
+    for(int c : cells)
+        count[c]++;
+    for(int c : cells)
+        if(count[c] > 1 && c != pacman)
+            stacked++;
+    for(int c : cells)
+        count[c] = 0;
+    return stacked;
+}
+
+int main() {
+    const int ticks = 300;
+    int failures = 0;
+
+    printf("%-10s %6s %7s %12s %12s %12s %14s %14s %10s\n", "maze", "loops", "ghosts", "flow us", "coop us", "coop max us",
+           "flow stacked", "coop stacked", "blocked");
+    for(int size : {200, 1000}) {
+        for(int loopPercent : {0, 30}) {
+            Grid grid = makeGrid(size, size, 29, loopPercent);
+            NavGraph graph;
+            graph.build(grid);
+            int V = graph.getV();
+            vector<int> count(V, 0);
+
+            for(int ghosts : {128, 512}) {
+                // ghosts start spread over a block of the maze around the middle, pacman walks randomly
+                vector<int> start(ghosts);
+                srand(size + ghosts + loopPercent);
+                for(int g=0; g<ghosts; g++)
+                    start[g] = (size / 2 - 20 + rand() % 40) * size + size / 2 - 20 + rand() % 40;
+                vector<int> pacmanWalk(ticks);
+                int pacman = (size / 2) * size + size / 2 + 60;
+                for(int t=0; t<ticks; t++) {
+                    if(t % 2 == 0) {
+                        NavGraph::Neighbors neighbors = graph.neighborsOf(pacman);
+                        pacman = neighbors.begin()[rand() % neighbors.size()];
+                    }
+                    pacmanWalk[t] = pacman;
+                }
+
+                FlowField field(graph);
+                double flowUs = 0, coopUs = 0, coopMaxUs = 0;
+                long long flowStacked = 0, coopStacked = 0;
+
+                // every ghost takes the flow field step
+                vector<int> cells = start, next(ghosts);
+                for(int t=0; t<ticks; t++) {
+                    field.update(pacmanWalk[t]);
+                    Timer timer;
+                    for(int g=0; g<ghosts; g++) {
+                        int n = field.getNextCell(cells[g]);
+                        next[g] = n == -1 ? cells[g] : n;
+                    }
+                    flowUs += timer.elapsedMs() * 1000;
+                    cells = next;
+                    flowStacked += countStacked(cells, count, pacmanWalk[t]);
+                }
+
+                // cooperative plans on top of the same flow field
+                CooperativePlanner planner(graph);
+                cells = start;
+                for(int t=0; t<ticks; t++) {
+                    field.update(pacmanWalk[t]);
+                    Timer timer;
+                    planner.getNextCells(cells.data(), ghosts, field, next.data());
+                    double us = timer.elapsedMs() * 1000;
+                    coopUs += us;
+                    if(us > coopMaxUs)
+                        coopMaxUs = us;
+                    for(int g=0; g<ghosts; g++) {
+                        bool valid = next[g] == cells[g];
+                        for(int k : graph.neighborsOf(cells[g]))
+                            valid |= k == next[g];
+                        if(!valid)
+                            failures++;
+                    }
+                    cells = next;
+                    coopStacked += countStacked(cells, count, pacmanWalk[t]);
+                }
+
+                char name[16];
+                snprintf(name, sizeof(name), "%dx%d", size, size);
+                printf("%-10s %5d%% %7d %12.1f %12.1f %12.1f %14.2f %14.2f %10d\n", name, loopPercent, ghosts, flowUs / ticks, coopUs / ticks,
+                       coopMaxUs, (double)flowStacked / ticks, (double)coopStacked / ticks, planner.getBlocked());
+            }
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d planned steps don't follow a passage\n", failures);
+        return 1;
+    }
+    return 0;
+}
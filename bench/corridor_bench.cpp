@@ -0,0 +1,86 @@
+// size of the contracted corridor graph and its query times against BFS and A* on mazes of increasing size
+#include <cstdio>
+#include <cstdlib>
+#include "Bfs.h"
+#include "AStar.h"
+#include "CorridorGraph.h"
+#include "BenchUtil.h"
+
+static int failures = 0;
+
+static void runCase(const char* name, const NavGraph &graph, int loopPercent, int queries) {
+    int V = graph.getV();
+    Timer timer;
+    CorridorGraph corridors(graph);
+    double buildMs = timer.elapsedMs();
+    BFS bfs(graph);
+    AStar astar(graph);
+
+    vector<int> sources(queries), dests(queries);
+    srand(V + loopPercent);
+    for(int i=0; i<queries; i++) {
+        sources[i] = rand() % V;
+        dests[i] = rand() % V;
+    }
+
+    vector<int> path, expected;
+    double ms[3];
+    PathFinder* finders[3] = {&bfs, &astar, &corridors};
+    for(int f=0; f<3; f++) {
+        timer.reset();
+        for(int i=0; i<queries; i++) {
+            finders[f]->getPath(sources[i], dests[i], path);
+            benchSink += path.size();
+        }
+        ms[f] = timer.elapsedMs() * 1000 / queries;
+    }
+
+    // the contracted path must be a valid path as short as the BFS one
+    for(int i=0; i<queries; i++) {
+        bfs.getPath(sources[i], dests[i], expected);
+        corridors.getPath(sources[i], dests[i], path);
+        int previous = sources[i];
+        bool valid = path.size() == expected.size() && (path.empty() || path.back() == dests[i]);
+        for(int cell : path) {
+            bool adjacent = false;
+            for(int k : graph.neighborsOf(previous))
+                adjacent |= k == cell;
+            valid &= adjacent;
+            previous = cell;
+        }
+        if(!valid)
+            failures++;
+    }
+
+    printf("%-10s %4d%% %10d %10d %9.1fx %10.1f %12.2f %12.2f %12.2f %8.1fx %8.1fx\n", name, loopPercent, V, corridors.getNodes(),
+           (double)V / corridors.getNodes(), buildMs, ms[0], ms[1], ms[2], ms[0] / ms[2], ms[1] / ms[2]);
+}
+
+int main() {
+    printf("%-10s %5s %10s %10s %10s %10s %12s %12s %12s %9s %9s\n", "maze", "loops", "cells", "nodes", "fewer", "build ms",
+           "BFS us", "A* us", "corridor us", "vs BFS", "vs A*");
+
+    srand(1);
+    Maze mazeClass;
+    mazeClass.generateMaze();
+    runCase("game", mazeClass.graph, 30, 100000);
+
+    const int sizes[4] = {100, 500, 1000, 2000};
+    const int queries[4] = {2000, 200, 50, 20};
+    for(int s=0; s<4; s++) {
+        char name[16];
+        snprintf(name, sizeof(name), "%dx%d", sizes[s], sizes[s]);
+        for(int loopPercent : {0, 10, 30}) {
+            Grid grid = makeGrid(sizes[s], sizes[s], 13, loopPercent);
+            NavGraph graph;
+            graph.build(grid);
+            runCase(name, graph, loopPercent, queries[s]);
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d corridor graph paths are wrong\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Eller's row by row generator: checks its mazes, compares it with Prim's and streams a maze of a million rows
+// without loops every maze must be perfect (connected with exactly cells-1 passages), with loops it must be connected,
+// and the rows of an endless maze must be the same as the rows of a finite maze from the same seed
+// the program fails if any of these doesn't hold
+#include <cstdio>
+#include <cmath>
+#include <queue>
+#include "Maze.h"
+#include "BenchUtil.h"
+
+static bool isConnected(const NavGraph &graph) {
+    vector<bool> seen(graph.getV(), false);
+    queue<int> open;
+    open.push(0);
+    seen[0] = true;
+    int reached = 1;
+    while(!open.empty()) {
+        int v = open.front();
+        open.pop();
+        for(int k: graph.neighborsOf(v)) {
+            if(!seen[k]) {
+                seen[k] = true;
+                reached++;
+                open.push(k);
+            }
+        }
+    }
+    return reached == graph.getV();
+}
+
+static long long countPassages(const NavGraph &graph) {
+    long long ends = 0;
+    for(int v=0; v<graph.getV(); v++)
+        ends += graph.degree(v);
+    return ends / 2;
+}
+
+static bool sameWalls(const Cell &a, const Cell &b) {
+    return a.wallUp() == b.wallUp() && a.wallDown() == b.wallDown() && a.wallLeft() == b.wallLeft() && a.wallRight() == b.wallRight();
+}
+
+int main() {
+    int failures = 0;
+
+    // perfect mazes straight from the generator
+    for(int m=0; m<200; m++) {
+        int size = 5 + m % 40;
+        Grid grid(size, size + 3);
+        for(size_t v=0; v<grid.size(); v++)
+            grid.at(v).closeAll();
+        EllerGenerator eller(size + 3, Random(m));
+        for(int i=0; i<size; i++)
+            eller.nextRow(grid[i], i == size - 1);
+        NavGraph graph;
+        graph.build(grid);
+        if(!isConnected(graph) || countPassages(graph) != graph.getV() - 1)
+            failures++;
+    }
+
+    // the game's mazes from both generators
+    double shares[2][5] = {{0}};
+    for(int m=0; m<400; m++) {
+        for(int g=0; g<2; g++) {
+            Maze mazeClass(20, 20, 7000 + m, g == 0 ? GENERATOR_PRIM : GENERATOR_ELLER);
+            mazeClass.generateMaze();
+            if(!isConnected(mazeClass.graph))
+                failures++;
+            for(int v=0; v<mazeClass.graph.getV(); v++)
+                shares[g][mazeClass.graph.degree(v)] += 1.0 / (400 * 400);
+        }
+    }
+    printf("passages per cell over 400 mazes of 20x20\n%8s %10s %10s\n", "passages", "prim", "eller");
+    for(int d=1; d<=4; d++)
+        printf("%8d %9.2f%% %9.2f%%\n", d, shares[0][d] * 100, shares[1][d] * 100);
+
+    // an endless maze makes the same rows as a finite one, all but the last row that joins everything
+    for(int m=0; m<20; m++) {
+        const int height = 200;
+        Maze finite(height, 30, 300 + m, GENERATOR_ELLER);
+        finite.generateMaze();
+        EndlessMaze endless(30, 16, 300 + m, ellerLoopChance);
+        for(int i=0; i<height - 1; i++) {
+            endless.advanceTo(i, 8);
+            if(!endless.isLoaded(i) || endless.isLoaded(endless.getFirstRow() - 1))
+                failures++;
+            for(int j=0; j<30; j++)
+                if(!sameWalls(endless[i][j], finite.grid[i][j]))
+                    failures++;
+        }
+    }
+
+    printf("\n%-12s %12s %12s %14s %14s\n", "maze", "prim ms", "eller ms", "prim ns/cell", "eller ns/cell");
+    for(int size : {100, 500, 1000, 2048}) {
+        Maze prim(size, size, size, GENERATOR_PRIM);
+        Timer timer;
+        prim.generateMaze();
+        double primMs = timer.elapsedMs();
+        Maze eller(size, size, size, GENERATOR_ELLER);
+        timer.reset();
+        eller.generateMaze();
+        double ellerMs = timer.elapsedMs();
+        if(!isConnected(eller.graph))
+            failures++;
+        char name[16];
+        snprintf(name, sizeof(name), "%dx%d", size, size);
+        double cells = (double)size * size;
+        printf("%-12s %12.2f %12.2f %14.1f %14.1f\n", name, primMs, ellerMs, primMs * 1e6 / cells, ellerMs * 1e6 / cells);
+    }
+
+    // a million rows of 100 cells: streamed through a window of 64 rows instead of a 95 MB grid
+    const long long streamRows = 1000000;
+    const int streamCols = 100, window = 64;
+    EndlessMaze endless(streamCols, window, 1, ellerLoopChance);
+    long long openings = 0;
+    Timer timer;
+    for(long long r=0; r<streamRows; r++) {
+        endless.advanceTo(r, window / 2);
+        for(int j=0; j<streamCols; j++)
+            openings += !endless[r][j].wallDown();
+    }
+    double streamMs = timer.elapsedMs();
+    benchSink += openings;
+    // what Prim's would need for the same maze: the grid and one frontier flag per cell
+    double gridMb = (double)streamRows * streamCols * sizeof(Cell) / (1 << 20);
+    double primMb = gridMb + (double)streamRows * streamCols / 8 / (1 << 20);
+    printf("\n%lld rows of %d cells: %.0f ms (%.1f ns/cell)\n", streamRows, streamCols, streamMs, streamMs * 1e6 / (streamRows * streamCols));
+    printf("eller row state %zu bytes, endless window of %d rows %zu bytes in all\n",
+           EllerGenerator(streamCols, Random(1)).getMemoryBytes(), window, endless.getMemoryBytes());
+    printf("a whole grid would take %.1f MB, with prim's frontier flags %.1f MB\n", gridMb, primMb);
+    if(endless.getGeneratedRows() != streamRows + window / 2)
+        failures++;
+
+    if(failures != 0) {
+        printf("ERROR: %d mazes that aren't connected or perfect, or endless rows that differ\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+// path engines compared on the game maze and on larger grids with different numbers of loops
+// every path is checked against BFS, the program fails if a length differs
+#include <cstdio>
+#include <cstdlib>
+#include "Navigation.h"
+#include "BenchUtil.h"
+
+static int failures = 0;
+
+// time queries random pairs on every engine and print one row per engine
+static void runCase(const char* name, const NavGraph &graph, int loopPercent, int queries) {
+    Navigation navigation;
+    navigation.build(graph);
+    int V = graph.getV();
+
+    vector<int> sources(queries), dests(queries);
+    srand(V + loopPercent);
+    for(int i=0; i<queries; i++) {
+        sources[i] = rand() % V;
+        dests[i] = rand() % V;
+    }
+
+    // reference lengths from BFS
+    vector<int> expected(queries);
+    vector<int> path;
+    for(int i=0; i<queries; i++) {
+        navigation.bfs.getPath(sources[i], dests[i], path);
+        expected[i] = (int)path.size();
+    }
+
+    const PathEngine engines[5] = {ENGINE_BFS, ENGINE_ASTAR, ENGINE_BIDIRECTIONAL, ENGINE_BITBOARD, ENGINE_HPA};
+    double bfsMs = 0;
+    for(PathEngine engine : engines) {
+        PathFinder &finder = navigation.getEngine(engine);
+        Timer timer;
+        for(int i=0; i<queries; i++) {
+            finder.getPath(sources[i], dests[i], path);
+            benchSink += path.size();
+            if((int)path.size() != expected[i])
+                failures++;
+        }
+        double ms = timer.elapsedMs();
+        if(engine == ENGINE_BFS)
+            bfsMs = ms;
+        printf("%-10s %4d%%  %-18s %12.2f %10.2fx\n", name, loopPercent, finder.getName(), ms * 1000 / queries, bfsMs / ms);
+    }
+}
+
+int main() {
+    printf("%-10s %5s  %-18s %12s %11s\n", "maze", "loops", "engine", "us/query", "vs BFS");
+
+    srand(1);
+    Maze mazeClass;
+    mazeClass.generateMaze();
+    runCase("game", mazeClass.graph, 30, 100000);
+
+    const int sizes[4] = {100, 500, 1000, 2000};
+    const int queries[4] = {1000, 100, 30, 10};
+    for(int s=0; s<4; s++) {
+        char name[16];
+        snprintf(name, sizeof(name), "%dx%d", sizes[s], sizes[s]);
+        for(int loopPercent : {0, 10, 30, 70}) {
+            Grid grid = makeGrid(sizes[s], sizes[s], 11, loopPercent);
+            NavGraph graph;
+            graph.build(grid);
+            runCase(name, graph, loopPercent, queries[s]);
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d paths have a different length than BFS\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+// scared ghosts: the old greedy manhattan choice against the shared flee field
+// measures the cost of one decision and how often pacman catches a ghost that runs away with each of them
+#include <cstdio>
+#include <cstdlib>
+#include "Bfs.h"
+#include "FleeField.h"
+#include "BenchUtil.h"
+
+// the choice scared ghosts made before the flee field, including the vector copies
+static int maxElement(vector<int> list) {
+    int max = 0;
+    for(size_t i=1; i<list.size(); i++)
+        if(list[i] > list[max])
+            max = i;
+    return max;
+}
+
+static int legacyRunningPath(const NavGraph &graph, int src, int pacman) {
+    int cols = graph.getCols();
+    vector<int> distances;
+    NavGraph::Neighbors neighbors = graph.neighborsOf(src);
+    for(int cord : neighbors)
+        distances.push_back(abs(pacman % cols - cord % cols) + abs(pacman / cols - cord / cols));
+    int next = neighbors.begin()[maxElement(distances)];
+    if(distances[maxElement(distances)] <= abs(pacman % cols - src % cols) + abs(pacman / cols - src / cols))
+        return src;
+    return next;
+}
+
+// pacman walks the shortest path to the ghost every step, the ghost moves on two of every three steps
+// returns the step it was caught at, or steps if it got away
+static int chase(const NavGraph &graph, FlowField &flowField, FleeField &fleeField, int pacman, int ghost, int steps, bool useFleeField) {
+    for(int s=0; s<steps; s++) {
+        flowField.update(ghost);
+        int next = flowField.getNextCell(pacman);
+        if(next != -1)
+            pacman = next;
+        if(pacman == ghost)
+            return s;
+        if(s % 3 != 2) {
+            flowField.update(pacman);
+            if(useFleeField) {
+                fleeField.update(flowField);
+                int flee = fleeField.getNextCell(ghost);
+                if(flee != -1)
+                    ghost = flee;
+            }else{
+                ghost = legacyRunningPath(graph, ghost, pacman);
+            }
+        }
+        if(pacman == ghost)
+            return s;
+    }
+    return steps;
+}
+
+int main() {
+    int failures = 0;
+    printf("%-10s %6s %14s %14s %16s %16s\n", "maze", "loops", "greedy ns", "flee ns", "greedy caught", "flee caught");
+
+    for(int size : {10, 30, 100}) {
+        for(int loopPercent : {0, 10, 30}) {
+            Grid grid = makeGrid(size, size, 23, loopPercent);
+            NavGraph graph;
+            graph.build(grid);
+            int V = graph.getV();
+            FlowField flowField(graph);
+            FleeField fleeField(graph);
+
+            // every cell is at most one step above its neighbors and never above its scaled distance
+            flowField.update(V / 2);
+            fleeField.update(flowField);
+            for(int v=0; v<V; v++) {
+                if(fleeField.getValue(v) > -6 * flowField.getDistance(v))
+                    failures++;
+                for(int k : graph.neighborsOf(v))
+                    if(fleeField.getValue(v) > fleeField.getValue(k) + 5)
+                        failures++;
+            }
+
+            // cost of one decision with pacman standing still
+            const int decisions = 1000000;
+            Timer timer;
+            for(int i=0; i<decisions; i++)
+                benchSink += legacyRunningPath(graph, i % V, V / 2);
+            double greedyNs = timer.elapsedMs() * 1e6 / decisions;
+            timer.reset();
+            for(int i=0; i<decisions; i++)
+                benchSink += fleeField.getNextCell(i % V);
+            double fleeNs = timer.elapsedMs() * 1e6 / decisions;
+
+            // pacman chasing one scared ghost from random starting cells
+            const int chases = size >= 100 ? 60 : 300;
+            const int steps = 4 * size;
+            int greedyCaught = 0, fleeCaught = 0;
+            srand(size + loopPercent);
+            for(int c=0; c<chases; c++) {
+                int pacman = rand() % V, ghost = rand() % V;
+                if(pacman == ghost)
+                    continue;
+                greedyCaught += chase(graph, flowField, fleeField, pacman, ghost, steps, false) < steps;
+                fleeCaught += chase(graph, flowField, fleeField, pacman, ghost, steps, true) < steps;
+            }
+
+            char name[16];
+            snprintf(name, sizeof(name), "%dx%d", size, size);
+            printf("%-10s %5d%% %14.1f %14.1f %12d/%d %12d/%d\n", name, loopPercent, greedyNs, fleeNs, greedyCaught, chases, fleeCaught, chases);
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d flee field values break the rescan rule\n", failures);
+        return 1;
+    }
+    return 0;
+}
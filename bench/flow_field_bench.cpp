@@ -0,0 +1,112 @@
+// cost of repairing the flow field compared with recomputing it, on large mazes
+// the benchmark mazes with no and with 30% extra openings, and the game's own Prim mazes
+#include <cstdio>
+#include <cstdlib>
+#include "Maze.h"
+#include "FlowField.h"
+#include "BenchUtil.h"
+
+// compare every distance of the repaired field with a field computed from scratch
+static int countDifferences(const FlowField &field, const NavGraph &graph) {
+    FlowField fresh(graph);
+    fresh.update(field.getTarget());
+    int differences = 0;
+    for(int v=0; v<graph.getV(); v++)
+        if(field.getDistance(v) != fresh.getDistance(v))
+            differences++;
+    return differences;
+}
+
+int main(int argc, char* argv[]) {
+    int size = argc > 1 ? atoi(argv[1]) : 1000;
+    const int moves = 500;
+    const int wallChanges = 500;
+    int failures = 0;
+
+    printf("maze %dx%d\n\n", size, size);
+    printf("%-16s %14s %14s %12s %16s\n", "operation", "repair ms", "recompute ms", "speedup", "cells touched");
+
+    const char* names[3] = {"0%", "30%", "prim"};
+    for(int c=0; c<3; c++) {
+        int loopPercent = c == 1 ? 30 : 0;
+        NavGraph graph;
+        if(c < 2) {
+            graph.build(makeGrid(size, size, 7, loopPercent));
+        }else{
+            Maze mazeClass(size, size, 7, GENERATOR_PRIM);
+            mazeClass.generateMaze();
+            graph.build(mazeClass.grid);
+        }
+        int V = graph.getV();
+
+        FlowField field(graph);
+        FlowField reference(graph);
+        int target = V / 2 + size / 2;
+        field.update(target);
+        reference.update(target);
+        srand(c + 1);
+
+        // pacman walking through the maze one cell at a time
+        double repairMs = 0, recomputeMs = 0;
+        long long touched = 0;
+        int searchesBefore = field.getSearches();
+        for(int m=0; m<moves; m++) {
+            NavGraph::Neighbors neighbors = graph.neighborsOf(target);
+            target = neighbors.begin()[rand() % neighbors.size()];
+
+            Timer timer;
+            field.update(target);
+            repairMs += timer.elapsedMs();
+            touched += field.getTouched();
+
+            reference.update(target);
+            timer.reset();
+            reference.rebuild();
+            recomputeMs += timer.elapsedMs();
+
+            if(m % 100 == 0)
+                failures += countDifferences(field, graph);
+        }
+        int fallbacks = field.getSearches() - searchesBefore;
+        printf("%-6s %9s %14.4f %14.4f %11.1fx %16lld   (%d full searches)\n", "move", names[c],
+               repairMs / moves, recomputeMs / moves, recomputeMs / repairMs, touched / moves, fallbacks);
+
+        // walls opening and closing somewhere in the maze
+        repairMs = recomputeMs = 0;
+        touched = 0;
+        for(int w=0; w<wallChanges; w++) {
+            int v, dir;
+            do {
+                v = rand() % V;
+                dir = rand() % 4;
+            } while((dir == 0 && v < size) || (dir == 1 && v >= V - size) || (dir == 2 && v % size == 0) || (dir == 3 && v % size == size - 1));
+            bool open = !field.isPassage(v, dir);
+
+            Timer timer;
+            field.setPassage(v, dir, open);
+            repairMs += timer.elapsedMs();
+            touched += field.getTouched();
+
+            reference.setPassage(v, dir, open);
+            timer.reset();
+            reference.rebuild();
+            recomputeMs += timer.elapsedMs();
+
+            if(w % 100 == 0) {
+                FlowField fresh = reference;
+                fresh.rebuild();
+                for(int c=0; c<V; c++)
+                    if(field.getDistance(c) != fresh.getDistance(c))
+                        failures++;
+            }
+        }
+        printf("%-6s %9s %14.4f %14.4f %11.1fx %16lld\n", "wall", names[c],
+               repairMs / wallChanges, recomputeMs / wallChanges, recomputeMs / repairMs, touched / wallChanges);
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d distances differ from a full recompute\n", failures);
+        return 1;
+    }
+    return 0;
+}
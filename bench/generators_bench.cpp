@@ -0,0 +1,104 @@
+// every maze generator at several sizes: time, peak memory and the shape of the mazes they make
+// peak memory is the grid plus the most the generator held besides it; the shape is the share of dead ends,
+// the average corridor length (passages between two cells that aren't plain corridor cells) and the number of loops
+// the program fails if a maze isn't connected or a generator that should make perfect mazes makes loops
+#include <cstdio>
+#include <memory>
+#include <queue>
+#include "Maze.h"
+#include "BenchUtil.h"
+
+static bool isConnected(const NavGraph &graph) {
+    vector<bool> seen(graph.getV(), false);
+    queue<int> open;
+    open.push(0);
+    seen[0] = true;
+    int reached = 1;
+    while(!open.empty()) {
+        int v = open.front();
+        open.pop();
+        for(int k: graph.neighborsOf(v)) {
+            if(!seen[k]) {
+                seen[k] = true;
+                reached++;
+                open.push(k);
+            }
+        }
+    }
+    return reached == graph.getV();
+}
+
+struct MazeShape {
+    double deadEndRatio;
+    double averageCorridor;
+    long long loops;
+};
+
+static MazeShape measureShape(const NavGraph &graph) {
+    MazeShape shape;
+    long long deadEnds = 0, passages = 0, corridors = 0, corridorLength = 0;
+    for(int v=0; v<graph.getV(); v++) {
+        passages += graph.degree(v);
+        if(graph.degree(v) == 1)
+            deadEnds++;
+        if(graph.degree(v) == 2)
+            continue;
+
+        // walk every corridor that leaves a dead end or junction, each corridor is walked once from both ends
+        for(int k : graph.neighborsOf(v)) {
+            int previous = v, current = k, length = 1;
+            while(graph.degree(current) == 2) {
+                int next = *graph.neighborsOf(current).begin();
+                if(next == previous)
+                    next = *(graph.neighborsOf(current).begin() + 1);
+                previous = current;
+                current = next;
+                length++;
+            }
+            corridors++;
+            corridorLength += length;
+        }
+    }
+    passages /= 2;
+    shape.deadEndRatio = (double)deadEnds / graph.getV();
+    shape.averageCorridor = corridors == 0 ? 0 : (double)corridorLength / corridors;
+    shape.loops = passages - graph.getV() + 1;
+    return shape;
+}
+
+int main() {
+    int failures = 0;
+    const MazeGenerator generators[] = {GENERATOR_PRIM, GENERATOR_ELLER, GENERATOR_TILED,
+                                        GENERATOR_KRUSKAL, GENERATOR_WILSON, GENERATOR_BACKTRACKER};
+
+    printf("%-12s %-10s %10s %10s %10s %11s %10s\n", "generator", "maze", "ms", "peak MB", "dead ends", "corridor", "loops");
+    for(int size : {100, 500, 1000, 2000}) {
+        for(MazeGenerator g : generators) {
+            Maze mazeClass(size, size, 17, g);
+            unique_ptr<Generator> generator(Maze::createGenerator(g));
+            Random random(17);
+            Timer timer;
+            generator->carve(mazeClass.grid, random);
+            double ms = timer.elapsedMs();
+            double peakMb = (double)(mazeClass.grid.getMemoryBytes() + generator->getPeakMemoryBytes()) / (1 << 20);
+
+            mazeClass.graph.build(mazeClass.grid);
+            MazeShape shape = measureShape(mazeClass.graph);
+            bool perfect = g == GENERATOR_KRUSKAL || g == GENERATOR_WILSON || g == GENERATOR_BACKTRACKER;
+            if(!isConnected(mazeClass.graph) || (perfect && shape.loops != 0))
+                failures++;
+
+            char name[16];
+            snprintf(name, sizeof(name), "%dx%d", size, size);
+            printf("%-12s %-10s %10.1f %10.2f %9.1f%% %11.2f %10lld\n", generator->getName(), name, ms, peakMb,
+                   shape.deadEndRatio * 100, shape.averageCorridor, shape.loops);
+        }
+        printf("\n");
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d mazes that aren't connected or have loops where they shouldn't\n", failures);
+        return 1;
+    }
+    return 0;
+}
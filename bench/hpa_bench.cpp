@@ -0,0 +1,97 @@
+// hierarchical search on very large mazes: preprocessing time, memory and query times against A* and BFS
+#include <cstdio>
+#include <cstdlib>
+#include "Bfs.h"
+#include "AStar.h"
+#include "HPAStar.h"
+#include "BenchUtil.h"
+
+// random cell at most radius rows and columns away from cell, like a ghost chasing pacman
+static int nearbyCell(int cell, int size, int radius) {
+    int r = cell / size + rand() % (2 * radius + 1) - radius;
+    int c = cell % size + rand() % (2 * radius + 1) - radius;
+    r = r < 0 ? 0 : (r >= size ? size - 1 : r);
+    c = c < 0 ? 0 : (c >= size ? size - 1 : c);
+    return r * size + c;
+}
+
+int main(int argc, char* argv[]) {
+    int size = argc > 1 ? atoi(argv[1]) : 4096;
+    int clusterSize = argc > 2 ? atoi(argv[2]) : HPAStar::defaultClusterSize;
+    const int queries = 200;
+    const int checks = 20;
+    int failures = 0;
+
+    printf("maze %dx%d, cluster %d\n", size, size, clusterSize);
+    for(int loopPercent : {0, 30}) {
+        NavGraph graph;
+        {
+            Grid grid = makeGrid(size, size, 5, loopPercent);
+            graph.build(grid);
+        }
+        int V = graph.getV();
+
+        Timer timer;
+        HPAStar hpa(graph, clusterSize);
+        double buildMs = timer.elapsedMs();
+        printf("\n%d%% loops: preprocessing %.0f ms, %d nodes, %d edges, %.1f MB (maze graph %.1f MB)\n", loopPercent, buildMs,
+               hpa.getNodes(), hpa.getEdges(), hpa.getMemoryBytes() / 1048576.0, (V + 1 + 2.0 * V) * sizeof(int) / 1048576.0);
+
+        AStar astar(graph);
+        BFS bfs(graph);
+        vector<int> path, expected;
+        srand(loopPercent + 3);
+        printf("%-14s %16s %16s\n", "pairs", "HPA* ms", "A* ms");
+        for(int radius : {32, 256, 0}) {
+            vector<int> sources(queries), dests(queries);
+            for(int i=0; i<queries; i++) {
+                sources[i] = rand() % V;
+                dests[i] = radius == 0 ? rand() % V : nearbyCell(sources[i], size, radius);
+            }
+
+            timer.reset();
+            for(int i=0; i<queries; i++) {
+                hpa.getPath(sources[i], dests[i], path);
+                benchSink += path.size();
+            }
+            double pathMs = timer.elapsedMs() / queries;
+
+            // A* is much slower on the far pairs, so only a few of them are timed
+            int timed = radius == 0 ? queries / 10 : queries;
+            timer.reset();
+            for(int i=0; i<timed; i++) {
+                astar.getPath(sources[i], dests[i], path);
+                benchSink += path.size();
+            }
+            double astarMs = timer.elapsedMs() / timed;
+
+            char name[32];
+            if(radius == 0) snprintf(name, sizeof(name), "random");
+            else snprintf(name, sizeof(name), "within %d", radius);
+            printf("%-14s %16.4f %16.4f\n", name, pathMs, astarMs);
+
+            // paths must be as short as BFS and go from neighbor to neighbor
+            for(int i=0; i<checks; i++) {
+                bfs.getPath(sources[i], dests[i], expected);
+                hpa.getPath(sources[i], dests[i], path);
+                if(path.size() != expected.size())
+                    failures++;
+                int previous = sources[i];
+                for(int cell : path) {
+                    bool adjacent = false;
+                    for(int k : graph.neighborsOf(previous))
+                        adjacent |= k == cell;
+                    if(!adjacent)
+                        failures++;
+                    previous = cell;
+                }
+            }
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d HPA* paths are wrong\n", failures);
+        return 1;
+    }
+    return 0;
+}
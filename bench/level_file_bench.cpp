@@ -0,0 +1,108 @@
+// level files from 100x100 to 4096x4096: file size, save time, time to map a file and to unpack it into a grid
+// the unpacked cells must equal the saved ones and files that aren't levels of this version must be refused,
+// the program fails otherwise
+#include <cstdio>
+#include "Maze.h"
+#include "BenchUtil.h"
+
+static bool sameCell(const Cell &a, const Cell &b) {
+    return a.wallUp() == b.wallUp() && a.wallDown() == b.wallDown() && a.wallLeft() == b.wallLeft()
+        && a.wallRight() == b.wallRight() && a.hasCoin() == b.hasCoin() && a.hasPowerup() == b.hasPowerup();
+}
+
+int main() {
+    int failures = 0;
+    const char *path = "level_file_bench.level";
+
+    printf("%-10s %10s %10s %10s %10s %12s %14s\n", "maze", "grid MB", "file MB", "save ms", "map ms", "unpack ms", "graph ms");
+    for(int size : {100, 1000, 4096}) {
+        Maze original(size, size, 5, GENERATOR_TILED);
+        original.generateMaze();
+        // take some pickups so the planes aren't all the same
+        for(int v=0; v<size*size; v+=7)
+            original.grid.at(v).setCoin(false);
+        vector<int> spawns = {0, size*size - 1, size - 1, (size - 1)*size};
+
+        Timer timer;
+        if(!original.saveLevel(path, spawns))
+            failures++;
+        double saveMs = timer.elapsedMs();
+
+        timer.reset();
+        LevelFile level;
+        if(!level.open(path)) {
+            printf("ERROR: can't open %s\n", path);
+            return 1;
+        }
+        double mapMs = timer.elapsedMs();
+
+        timer.reset();
+        Grid grid;
+        level.unpack(grid);
+        double unpackMs = timer.elapsedMs();
+
+        timer.reset();
+        Maze loaded(level);
+        double mazeMs = timer.elapsedMs();
+
+        if(level.getRows() != size || level.getCols() != size || level.getSeed() != 5 || level.getGenerator() != GENERATOR_TILED
+           || level.getGhostCount() != 4)
+            failures++;
+        for(int i=0; i<4; i++)
+            if(level.getGhostSpawn(i) != spawns[i])
+                failures++;
+        for(int v=0; v<size*size; v++) {
+            if(!sameCell(grid.at(v), original.grid.at(v)) || !sameCell(loaded.grid.at(v), original.grid.at(v)))
+                failures++;
+        }
+        for(int v=0; v<original.graph.getV(); v++)
+            if(loaded.graph.degree(v) != original.graph.degree(v))
+                failures++;
+
+        char name[16];
+        snprintf(name, sizeof(name), "%dx%d", size, size);
+        printf("%-10s %10.2f %10.2f %10.2f %10.3f %12.2f %14.2f\n", name, (double)original.grid.getMemoryBytes() / (1 << 20),
+               (double)level.getFileBytes() / (1 << 20), saveMs, mapMs, unpackMs, mazeMs - unpackMs);
+    }
+    printf("(graph ms is the rest of Maze(level): building the navigation graph and the pickup sets)\n");
+
+    // files that must be refused: another version, cut short, not a level
+    {
+        Maze small(20, 20, 1);
+        small.generateMaze();
+        small.saveLevel(path, vector<int>(4, 0));
+        FILE *file = fopen(path, "rb");
+        vector<char> bytes(1 << 16);
+        bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+        fclose(file);
+
+        LevelFile level;
+        vector<char> changed = bytes;
+        uint32_t version = LevelFile::currentVersion + 1;
+        memcpy(&changed[4], &version, sizeof(version));
+        file = fopen(path, "wb");
+        fwrite(changed.data(), 1, changed.size(), file);
+        fclose(file);
+        if(level.open(path))
+            failures++;
+
+        file = fopen(path, "wb");
+        fwrite(bytes.data(), 1, bytes.size() / 2, file);
+        fclose(file);
+        if(level.open(path))
+            failures++;
+
+        file = fopen(path, "wb");
+        fputs("not a level file", file);
+        fclose(file);
+        if(level.open(path))
+            failures++;
+    }
+    remove(path);
+
+    if(failures != 0) {
+        printf("ERROR: %d cells or header fields that differ, or bad files that were accepted\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+// Maze::generateMaze from 10x10 to 4096x4096, with the old frontier (linear contains() and erase from the middle) for comparison
+// both pick a uniformly random frontier cell, so the mazes they make have the same distribution:
+// many small mazes from each are compared by their share of dead ends and of cells with 2, 3 and 4 passages
+// every maze has its own seeded generator: the same seed has to make the same maze, also when mazes are generated on threads,
+// and the time for a batch of mazes on one thread and on several threads is reported
+// the program fails if a maze isn't connected, the shares differ by more than a small tolerance or a seed makes two different mazes
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <thread>
+#include "Maze.h"
+#include "BenchUtil.h"
+
+// the generator as it was before the frontier got its flags, with the shared rand()
+static bool legacyContains(vector<pair<int, int>> walls, int row, int col) {
+    for(pair<int,int> wall: walls)
+        if(wall.first==row && wall.second==col)
+            return true;
+    return false;
+}
+
+static void legacyGenerate(Maze &mazeClass) {
+    int startRow = rand() % mazeClass.getRows();
+    int startCol = rand() % mazeClass.getCols();
+    mazeClass.grid[startRow][startCol].setVisited(true);
+    vector<pair<int, int>> unvisitedCells;
+    if (mazeClass.isNotVisited(startRow - 1, startCol)) unvisitedCells.push_back(make_pair(startRow - 1, startCol));
+    if (mazeClass.isNotVisited(startRow + 1, startCol)) unvisitedCells.push_back(make_pair(startRow + 1, startCol));
+    if (mazeClass.isNotVisited(startRow, startCol - 1)) unvisitedCells.push_back(make_pair(startRow, startCol - 1));
+    if (mazeClass.isNotVisited(startRow, startCol + 1)) unvisitedCells.push_back(make_pair(startRow, startCol + 1));
+
+    while (!unvisitedCells.empty()) {
+        int randomIndex = rand() % unvisitedCells.size();
+        int currentRow = unvisitedCells[randomIndex].first;
+        int currentCol = unvisitedCells[randomIndex].second;
+        mazeClass.grid[currentRow][currentCol].setVisited(true);
+
+        vector<pair<int, int>> neighbors;
+        if (mazeClass.isVisited(currentRow - 1, currentCol)) neighbors.push_back(make_pair(currentRow - 1, currentCol));
+        if (mazeClass.isVisited(currentRow + 1, currentCol)) neighbors.push_back(make_pair(currentRow + 1, currentCol));
+        if (mazeClass.isVisited(currentRow, currentCol - 1)) neighbors.push_back(make_pair(currentRow, currentCol - 1));
+        if (mazeClass.isVisited(currentRow, currentCol + 1)) neighbors.push_back(make_pair(currentRow, currentCol + 1));
+
+        if (!neighbors.empty()) {
+            int connections = rand() % 100 >= 30 && neighbors.size() > 1 ? 2 : 1;
+            for(int i=0; i<connections; i++) {
+                int randomNeighborIndex = rand() % neighbors.size();
+                mazeClass.addNeighbor(currentRow, currentCol, neighbors[randomNeighborIndex].first, neighbors[randomNeighborIndex].second);
+                neighbors.erase(neighbors.begin() + randomNeighborIndex);
+            }
+        }
+        unvisitedCells.erase(unvisitedCells.begin() + randomIndex);
+
+        if (mazeClass.isNotVisited(currentRow - 1, currentCol) && !legacyContains(unvisitedCells,currentRow - 1, currentCol)) unvisitedCells.push_back(make_pair(currentRow - 1, currentCol));
+        if (mazeClass.isNotVisited(currentRow + 1, currentCol) && !legacyContains(unvisitedCells,currentRow + 1, currentCol)) unvisitedCells.push_back(make_pair(currentRow + 1, currentCol));
+        if (mazeClass.isNotVisited(currentRow, currentCol - 1) && !legacyContains(unvisitedCells,currentRow, currentCol-1)) unvisitedCells.push_back(make_pair(currentRow, currentCol - 1));
+        if (mazeClass.isNotVisited(currentRow, currentCol + 1) && !legacyContains(unvisitedCells,currentRow, currentCol+1)) unvisitedCells.push_back(make_pair(currentRow, currentCol + 1));
+    }
+    mazeClass.graph.build(mazeClass.grid);
+}
+
+static bool isConnected(const NavGraph &graph) {
+    vector<bool> seen(graph.getV(), false);
+    queue<int> open;
+    open.push(0);
+    seen[0] = true;
+    int reached = 1;
+    while(!open.empty()) {
+        int v = open.front();
+        open.pop();
+        for(int k: graph.neighborsOf(v)) {
+            if(!seen[k]) {
+                seen[k] = true;
+                reached++;
+                open.push(k);
+            }
+        }
+    }
+    return reached == graph.getV();
+}
+
+static bool sameCells(const Maze &a, const Maze &b) {
+    return a.grid.getRows() == b.grid.getRows() && a.grid.getCols() == b.grid.getCols()
+        && memcmp(&a.grid.at(0), &b.grid.at(0), (size_t)a.grid.getRows() * a.grid.getCols() * sizeof(Cell)) == 0;
+}
+
+// adds the number of cells with each number of passages
+static void countDegrees(const NavGraph &graph, double shares[5]) {
+    for(int v=0; v<graph.getV(); v++)
+        shares[graph.degree(v)] += 1.0;
+}
+
+int main() {
+    int failures = 0;
+
+    // same distribution: 400 mazes of 20x20 from each generator
+    double legacyShares[5] = {0}, shares[5] = {0};
+    for(int m=0; m<400; m++) {
+        srand(1000 + m);
+        Maze legacy(20, 20, 0);
+        legacyGenerate(legacy);
+        countDegrees(legacy.graph, legacyShares);
+        Maze current(20, 20, 5000 + m);
+        current.generateMaze();
+        countDegrees(current.graph, shares);
+        if(!isConnected(current.graph))
+            failures++;
+    }
+    printf("passages per cell over 400 mazes of 20x20\n%8s %10s %10s\n", "passages", "old", "new");
+    for(int d=1; d<=4; d++) {
+        legacyShares[d] /= 400 * 400;
+        shares[d] /= 400 * 400;
+        printf("%8d %9.2f%% %9.2f%%\n", d, legacyShares[d] * 100, shares[d] * 100);
+        if(fabs(legacyShares[d] - shares[d]) > 0.01)
+            failures++;
+    }
+
+    printf("\n%-10s %12s %12s %14s\n", "maze", "old ms", "new ms", "new ns/cell");
+    for(int size : {10, 50, 100, 200, 500, 1000, 2048, 4096}) {
+        double legacyMs = -1;
+        // the old frontier is quadratic, it is only timed where it finishes in reasonable time
+        if(size <= 200) {
+            srand(size);
+            Maze legacy(size, size, 0);
+            Timer timer;
+            legacyGenerate(legacy);
+            legacyMs = timer.elapsedMs();
+        }
+        Maze current(size, size, size);
+        Timer timer;
+        current.generateMaze();
+        double ms = timer.elapsedMs();
+        if(!isConnected(current.graph))
+            failures++;
+
+        char name[16], old[16];
+        snprintf(name, sizeof(name), "%dx%d", size, size);
+        if(legacyMs < 0)
+            snprintf(old, sizeof(old), "-");
+        else
+            snprintf(old, sizeof(old), "%.2f", legacyMs);
+        printf("%-10s %12s %12.2f %14.1f\n", name, old, ms, ms * 1e6 / ((double)size * size));
+    }
+
+    // a batch of 100x100 mazes, first one after another, then spread over threads; each must match its sequential twin
+    const int batch = 64, threadCount = 4;
+    vector<Maze> sequential, parallel;
+    for(int m=0; m<batch; m++) {
+        sequential.push_back(Maze(100, 100, 9000 + m));
+        parallel.push_back(Maze(100, 100, 9000 + m));
+    }
+    Timer timer;
+    for(Maze &mazeClass : sequential)
+        mazeClass.generateMaze();
+    double sequentialMs = timer.elapsedMs();
+    timer.reset();
+    vector<thread> workers;
+    for(int t=0; t<threadCount; t++) {
+        workers.push_back(thread([&parallel, t]() {
+            for(int m=t; m<batch; m+=threadCount)
+                parallel[m].generateMaze();
+        }));
+    }
+    for(thread &worker : workers)
+        worker.join();
+    double parallelMs = timer.elapsedMs();
+    for(int m=0; m<batch; m++)
+        if(!sameCells(sequential[m], parallel[m]))
+            failures++;
+    Maze again(100, 100, 9000);
+    again.generateMaze();
+    if(!sameCells(again, sequential[0]))
+        failures++;
+    printf("\n%d mazes of 100x100: %.2f ms on one thread, %.2f ms on %d threads (%u cores)\n",
+           batch, sequentialMs, parallelMs, threadCount, thread::hardware_concurrency());
+
+    if(failures != 0) {
+        printf("ERROR: %d disconnected mazes, passage shares that differ or seeds that made different mazes\n", failures);
+        return 1;
+    }
+    return 0;
+}
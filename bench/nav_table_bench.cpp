@@ -0,0 +1,81 @@
+// compares the all-pairs navigation table with running a BFS for every ghost step
+#include <cstdio>
+#include <cstdlib>
+#include "Maze.h"
+#include "Bfs.h"
+#include "NavTable.h"
+#include "BenchUtil.h"
+
+int main() {
+    const int mazes = 20;
+    const int steps = 100;
+    const int ghostCounts[] = {4, 64, 256, 1024};
+
+    printf("maze %dx%d, %d mazes, %d steps per ghost\n\n", rows, cols, mazes, steps);
+    printf("%8s %16s %16s %10s\n", "ghosts", "BFS ns/step", "table ns/step", "speedup");
+
+    double buildMs = 0;
+    int mismatches = 0;
+
+    for(int ghosts : ghostCounts) {
+        double bfsMs = 0, tableMs = 0;
+
+        for(int m=0; m<mazes; m++) {
+            srand(m);
+            Maze mazeClass(rows, cols, m);
+            mazeClass.generateMaze();
+
+            Timer timer;
+            NavTable table;
+            table.build(mazeClass.graph);
+            buildMs += timer.elapsedMs();
+
+            BFS algorithm(mazeClass.graph);
+
+            // every ghost starts on a random cell and chases a random target that changes every step
+            vector<int> sources(ghosts), dests((size_t)ghosts * steps);
+            for(int g=0; g<ghosts; g++)
+                sources[g] = rand() % (rows*cols);
+            for(size_t i=0; i<dests.size(); i++)
+                dests[i] = rand() % (rows*cols);
+
+            vector<int> position = sources;
+            timer.reset();
+            for(int s=0; s<steps; s++) {
+                for(int g=0; g<ghosts; g++) {
+                    vector<int> path = algorithm.getPath(position[g], dests[(size_t)s*ghosts + g]);
+                    if(!path.empty())
+                        position[g] = path[0];
+                }
+            }
+            bfsMs += timer.elapsedMs();
+            vector<int> bfsPosition = position;
+
+            position = sources;
+            timer.reset();
+            for(int s=0; s<steps; s++) {
+                for(int g=0; g<ghosts; g++) {
+                    int next = table.getNextCell(position[g], dests[(size_t)s*ghosts + g]);
+                    if(next != -1)
+                        position[g] = next;
+                }
+            }
+            tableMs += timer.elapsedMs();
+
+            // both must walk the ghosts along the same cells
+            for(int g=0; g<ghosts; g++)
+                if(position[g] != bfsPosition[g])
+                    mismatches++;
+        }
+
+        double queries = (double)mazes * steps * ghosts;
+        printf("%8d %16.1f %16.1f %9.1fx\n", ghosts, bfsMs * 1e6 / queries, tableMs * 1e6 / queries, bfsMs / tableMs);
+    }
+
+    printf("\ntable build: %.3f ms per maze, %zu bytes\n", buildMs / (mazes * 4), (size_t)(rows*cols) * (rows*cols) * 3);
+    if(mismatches != 0) {
+        printf("ERROR: %d ghosts ended on a different cell than with BFS\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// ghosts chasing pacman with A*, searching again on every cell against keeping the last path until pacman changes cells
+// pacman moves once every few ghost steps, the faster pacman is compared to the ghosts the fewer searches are saved
+// a ghost that catches pacman goes back to its start
+// reports searches, cache hit rate and total time, every 50th hit is checked to still be a shortest path
+#include <cstdio>
+#include <cstdlib>
+#include "Navigation.h"
+#include "BenchUtil.h"
+
+int main() {
+    const int ghostCount = 8;
+    int failures = 0;
+
+    printf("%-10s %6s %12s %-7s %10s %10s %10s\n", "maze", "loops", "pacman step", "mode", "searches", "hit rate", "ms");
+    for(int size : {200, 1000}) {
+        Grid grid = makeGrid(size, size, 37, 30);
+        NavGraph graph;
+        graph.build(grid);
+        int V = graph.getV();
+        Navigation navigation;
+        navigation.build(graph);
+        PathFinder &astar = navigation.getEngine(ENGINE_ASTAR);
+        BFS check(graph);
+        vector<int> expected;
+        int steps = size < 500 ? 2000 : 500;
+
+        for(int every : {1, 2, 4}) {
+            // pacman walks randomly and moves once every few ghost steps
+            srand(size + every);
+            vector<int> pacmanWalk(steps);
+            int pacman = rand() % V;
+            for(int s=0; s<steps; s++) {
+                if(s % every == 0) {
+                    NavGraph::Neighbors neighbors = graph.neighborsOf(pacman);
+                    pacman = neighbors.begin()[rand() % neighbors.size()];
+                }
+                pacmanWalk[s] = pacman;
+            }
+            vector<int> start(ghostCount);
+            for(int g=0; g<ghostCount; g++)
+                start[g] = rand() % V;
+
+            char name[16];
+            snprintf(name, sizeof(name), "%dx%d", size, size);
+            for(int cached = 0; cached < 2; cached++) {
+                PathCacheStats stats;
+                vector<PathCache> paths(ghostCount, PathCache(stats));
+                vector<int> cells = start;
+                long long searches = 0, hits = 0;
+                Timer timer;
+                for(int s=0; s<steps; s++) {
+                    int dest = pacmanWalk[s];
+                    for(int g=0; g<ghostCount; g++) {
+                        PathCache &path = paths[g];
+                        if(path.next() == cells[g])
+                            path.advance();
+                        if(!cached || !path.lookup(dest, navigation.getVersion())) {
+                            astar.getPathStart(cells[g], dest, path.store(dest, navigation.getVersion()));
+                            searches++;
+                        }else if(++hits % 50 == 0) {
+                            check.getPath(cells[g], dest, expected);
+                            if(expected.size() != path.remaining())
+                                failures++;
+                        }
+                        if(!path.empty())
+                            cells[g] = path.next();
+                        // a ghost that caught pacman starts over like in the game
+                        if(cells[g] == dest) {
+                            cells[g] = start[g];
+                            path.setNext(-1);
+                        }
+                    }
+                }
+                double ms = timer.elapsedMs();
+                printf("%-10s %5d%% %12d %-7s %10lld %9.1f%% %10.1f\n", name, 30, every, cached ? "cache" : "search",
+                       searches, stats.getHitRate() * 100, ms);
+            }
+        }
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d cached paths are not shortest paths anymore\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+// coins and powerups as bitsets against reading them from the cells, from a full board to a nearly empty one
+// per frame the game draws the pickups within the draw distance and checks if any are left:
+// the cell scan visits every cell of the draw range and, to count, every cell of the maze,
+// the bitsets only visit set bits and keep the count
+// the program fails if both ways don't find the same cells and counts
+#include <cstdio>
+#include "Maze.h"
+#include "BenchUtil.h"
+
+int main() {
+    int failures = 0;
+    const int drawDistance = 100;
+
+    printf("%-10s %8s %12s %14s %14s %14s %14s\n", "maze", "left", "pickups", "scan draw ms", "bits draw ms", "scan count ms", "bits count ms");
+    for(int size : {100, 1000, 4096}) {
+        Maze mazeClass(size, size, 3, GENERATOR_TILED);
+        mazeClass.generateMaze();
+        Random random(size);
+
+        int centerRow = size / 2, centerCol = size / 2;
+        int rowFrom = max(0, centerRow - drawDistance), rowTo = min(size, centerRow + drawDistance + 1);
+        int colFrom = max(0, centerCol - drawDistance), colTo = min(size, centerCol + drawDistance + 1);
+
+        // the board as the game goes on: all, a tenth and a hundredth of the pickups left
+        int previous = 100;
+        for(int percent : {100, 10, 1}) {
+            // keep percent of the pickups of the whole board, out of the previous percent still there
+            int keep = percent * 1000 / previous;
+            previous = percent;
+            for(int i=0; i<size; i++) {
+                for(int j=0; j<size; j++) {
+                    if((int)random.below(1000) >= keep) {
+                        mazeClass.coins.take(i, j);
+                        mazeClass.powerups.take(i, j);
+                        mazeClass.grid[i][j].setCoin(false);
+                        mazeClass.grid[i][j].setPowerup(false);
+                    }
+                }
+            }
+
+            const int repeats = size <= 1000 ? 50 : 5;
+            long long scanDrawn = 0, bitsDrawn = 0;
+            Timer timer;
+            for(int r=0; r<repeats; r++)
+                for(int i=rowFrom; i<rowTo; i++)
+                    for(int j=colFrom; j<colTo; j++)
+                        scanDrawn += mazeClass.grid[i][j].hasCoin() * (i + j) + mazeClass.grid[i][j].hasPowerup() * (i - j);
+            double scanDrawMs = timer.elapsedMs() / repeats;
+
+            timer.reset();
+            for(int r=0; r<repeats; r++) {
+                mazeClass.coins.forEach(rowFrom, rowTo, colFrom, colTo, [&](int i, int j) { bitsDrawn += i + j; });
+                mazeClass.powerups.forEach(rowFrom, rowTo, colFrom, colTo, [&](int i, int j) { bitsDrawn += i - j; });
+            }
+            double bitsDrawMs = timer.elapsedMs() / repeats;
+
+            long long scanCount = 0, bitsCount = 0;
+            timer.reset();
+            for(int r=0; r<repeats; r++)
+                for(size_t v=0; v<mazeClass.grid.size(); v++)
+                    scanCount += mazeClass.grid.at(v).hasCoin() + mazeClass.grid.at(v).hasPowerup();
+            double scanCountMs = timer.elapsedMs() / repeats;
+
+            timer.reset();
+            for(int r=0; r<repeats; r++)
+                bitsCount += mazeClass.remainingPickups();
+            double bitsCountMs = timer.elapsedMs() / repeats;
+
+            if(scanDrawn != bitsDrawn || scanCount != bitsCount)
+                failures++;
+            // the kept count must match a fresh popcount
+            size_t kept = mazeClass.remainingPickups();
+            if(mazeClass.coins.recount() + mazeClass.powerups.recount() != kept)
+                failures++;
+
+            char name[16], left[16];
+            snprintf(name, sizeof(name), "%dx%d", size, size);
+            snprintf(left, sizeof(left), "%d%%", percent);
+            printf("%-10s %8s %12zu %14.4f %14.4f %14.4f %14.6f\n", name, left, kept, scanDrawMs, bitsDrawMs, scanCountMs, bitsCountMs);
+        }
+    }
+
+    // a board taken cell by cell is empty exactly when the last pickup is gone
+    Maze small(10, 10, 8);
+    small.generateMaze();
+    for(int v=0; v<100; v++) {
+        if(small.remainingPickups() == 0)
+            failures++;
+        small.coins.take(v / 10, v % 10);
+        small.powerups.take(v / 10, v % 10);
+    }
+    if(small.remainingPickups() != 0)
+        failures++;
+
+    if(failures != 0) {
+        printf("ERROR: %d differences between the bitsets and the cells\n", failures);
+        return 1;
+    }
+    return 0;
+}
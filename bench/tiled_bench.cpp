@@ -0,0 +1,115 @@
+// tiled maze generation on 1 to 8 threads, in cells per second, against Prim's on one thread
+// without loops every maze must be perfect (connected with exactly cells-1 passages), with loops it must be connected,
+// and the same seed must give the same maze on any number of threads
+// the program fails if any of these doesn't hold
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include "Maze.h"
+#include "BenchUtil.h"
+
+static bool isConnected(const NavGraph &graph) {
+    vector<bool> seen(graph.getV(), false);
+    queue<int> open;
+    open.push(0);
+    seen[0] = true;
+    int reached = 1;
+    while(!open.empty()) {
+        int v = open.front();
+        open.pop();
+        for(int k: graph.neighborsOf(v)) {
+            if(!seen[k]) {
+                seen[k] = true;
+                reached++;
+                open.push(k);
+            }
+        }
+    }
+    return reached == graph.getV();
+}
+
+static long long countPassages(const NavGraph &graph) {
+    long long ends = 0;
+    for(int v=0; v<graph.getV(); v++)
+        ends += graph.degree(v);
+    return ends / 2;
+}
+
+static Grid closedGrid(int rows, int cols) {
+    Grid grid(rows, cols);
+    for(size_t v=0; v<grid.size(); v++)
+        grid.at(v).closeAll();
+    return grid;
+}
+
+static bool sameCells(const Grid &a, const Grid &b) {
+    return a.size() == b.size() && memcmp(&a.at(0), &b.at(0), a.size() * sizeof(Cell)) == 0;
+}
+
+int main() {
+    int failures = 0;
+
+    // sizes that don't divide into tiles, tiles of one cell width, and a single tile
+    const int shapes[][3] = {{37, 53, 8}, {300, 300, 64}, {129, 65, 64}, {64, 1, 4}, {20, 20, 256}, {100, 257, 1}};
+    for(const int *shape : shapes) {
+        for(int loops = 0; loops < 2; loops++) {
+            Grid single = closedGrid(shape[0], shape[1]);
+            TiledGenerator(shape[2], 1, loops ? ellerLoopChance : 0).generate(single, 11);
+            Grid parallel = closedGrid(shape[0], shape[1]);
+            TiledGenerator(shape[2], 4, loops ? ellerLoopChance : 0).generate(parallel, 11);
+            if(!sameCells(single, parallel))
+                failures++;
+
+            NavGraph graph;
+            graph.build(parallel);
+            if(!isConnected(graph) || (!loops && countPassages(graph) != graph.getV() - 1))
+                failures++;
+        }
+    }
+
+    const int size = 4096;
+    const double cells = (double)size * size;
+    printf("%dx%d maze, tiles of 256, %u cores\n%-22s %10s %16s\n", size, size, thread::hardware_concurrency(), "generator", "ms", "Mcells/s");
+
+    {
+        Maze prim(size, size, 3, GENERATOR_PRIM);
+        Random random(3);
+        Timer timer;
+        PrimGenerator().carve(prim.grid, random);
+        double ms = timer.elapsedMs();
+        printf("%-22s %10.1f %16.1f\n", "prim, 1 thread", ms, cells / ms / 1e3);
+    }
+
+    Grid reference;
+    for(int threads : {1, 2, 4, 8}) {
+        Grid grid = closedGrid(size, size);
+        Timer timer;
+        TiledGenerator(256, threads).generate(grid, 3);
+        double ms = timer.elapsedMs();
+        char name[32];
+        snprintf(name, sizeof(name), "tiled, %d thread%s", threads, threads > 1 ? "s" : "");
+        printf("%-22s %10.1f %16.1f\n", name, ms, cells / ms / 1e3);
+        if(threads == 1)
+            reference = grid;
+        else if(!sameCells(reference, grid))
+            failures++;
+    }
+
+    // the level-prep size, once on all cores
+    {
+        const int large = 16384;
+        Grid grid = closedGrid(large, large);
+        TiledGenerator tiled;
+        Timer timer;
+        tiled.generate(grid, 3);
+        double ms = timer.elapsedMs();
+        printf("\n%dx%d on %d threads: %.0f ms, %.1f Mcells/s, grid %.0f MB\n",
+               large, large, tiled.getThreads(), ms, (double)large * large / ms / 1e3, (double)grid.getMemoryBytes() / (1 << 20));
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d mazes that aren't connected or perfect, or that depend on the number of threads\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+// maze topology against brute force on small mazes, then its build time and memory next to the graph's on large ones
+// articulation points are checked by taking each cell out and counting the components left, bridges by closing
+// each passage, loops by counting the passages that join cells already connected; the dead end chains must cover
+// every dead end and only corridor cells, and BFS with the topology must fail fast between two parts of a maze
+// the program fails on any difference
+#include <cstdio>
+#include <queue>
+#include <memory>
+#include "Bfs.h"
+#include "BenchUtil.h"
+
+static int failures = 0;
+
+// components of the graph with one cell or one passage left out, -1 for none
+static int countComponents(const NavGraph &graph, int skipCell, int skipA = -1, int skipB = -1) {
+    vector<bool> seen(graph.getV(), false);
+    int components = 0;
+    for(int root=0; root<graph.getV(); root++) {
+        if(seen[root] || root == skipCell)
+            continue;
+        components++;
+        queue<int> open;
+        open.push(root);
+        seen[root] = true;
+        while(!open.empty()) {
+            int v = open.front();
+            open.pop();
+            for(int k : graph.neighborsOf(v)) {
+                if(seen[k] || k == skipCell || (v == skipA && k == skipB) || (v == skipB && k == skipA))
+                    continue;
+                seen[k] = true;
+                open.push(k);
+            }
+        }
+    }
+    return components;
+}
+
+static int findRoot(vector<int> &parent, int v) {
+    while(parent[v] != v)
+        v = parent[v] = parent[parent[v]];
+    return v;
+}
+
+// rebuilt for every small maze, its stamped search memory must give the same results as a new topology
+static MazeTopology reused;
+
+static void checkTopology(const char *name, const NavGraph &graph) {
+    MazeTopology topology(graph);
+    int V = graph.getV();
+    int before = failures;
+
+    reused.build(graph);
+    if(reused.getComponents() != topology.getComponents() || reused.getLoops() != topology.getLoops()
+       || reused.getArticulationPoints() != topology.getArticulationPoints() || reused.getBridges() != topology.getBridges())
+        failures++;
+    for(int v=0; v<V; v++)
+        if(reused.isArticulation(v) != topology.isArticulation(v) || reused.getComponent(v) != topology.getComponent(v))
+            failures++;
+
+    int components = countComponents(graph, -1);
+    if(topology.getComponents() != components)
+        failures++;
+
+    // a passage between two cells that are already joined closes a loop
+    vector<int> parent(V);
+    for(int v=0; v<V; v++)
+        parent[v] = v;
+    long long loops = 0;
+    for(int v=0; v<V; v++) {
+        for(int k : graph.neighborsOf(v)) {
+            if(k < v)
+                continue;
+            int a = findRoot(parent, v), b = findRoot(parent, k);
+            if(a == b)
+                loops++;
+            else
+                parent[a] = b;
+            bool bridge = countComponents(graph, -1, v, k) > components;
+            if(topology.isBridge(v, k) != bridge || topology.isBridge(k, v) != bridge)
+                failures++;
+        }
+    }
+    if(topology.getLoops() != loops)
+        failures++;
+
+    for(int v=0; v<V; v++) {
+        // taking out a cell that is alone removes its component
+        int without = countComponents(graph, v) + (graph.degree(v) == 0 ? 1 : 0);
+        if(topology.isArticulation(v) != (without > components))
+            failures++;
+        if(topology.degree(v) != graph.degree(v) || topology.isJunction(v) != (graph.degree(v) >= 3))
+            failures++;
+        if(topology.isConnected(v, 0) != (findRoot(parent, v) == findRoot(parent, 0)))
+            failures++;
+    }
+
+    // the chains hold every dead end and otherwise corridor cells, each chain cell is on exactly one chain
+    int chainCells = 0;
+    for(int v=0; v<V; v++) {
+        int id = topology.getChain(v);
+        if(topology.isDeadEnd(v) && id < 0)
+            failures++;
+        if(id >= 0) {
+            chainCells++;
+            if(graph.degree(v) != 1 && graph.degree(v) != 2)
+                failures++;
+        }
+    }
+    int lengths = 0;
+    for(const DeadEndChain &chain : topology.getChains()) {
+        lengths += chain.length;
+        if(!topology.isDeadEnd(chain.deadEnd) || (chain.exit >= 0 && !topology.isJunction(chain.exit)))
+            failures++;
+    }
+    if(lengths != chainCells)
+        failures++;
+
+    // searches between the parts of a maze that isn't connected fail
+    BFS bfs(graph, &topology);
+    vector<int> path;
+    for(int v=1; v<V; v+=7)
+        if(bfs.getPath(0, v, path) != topology.isConnected(0, v))
+            failures++;
+
+    printf("%-24s %6d %6d %6lld %6d %6zu %6zu %8d %8lld %s\n", name, V, topology.getComponents(), topology.getLoops(),
+           topology.getDeadEnds(), topology.getChains().size(), topology.getJunctions().size(),
+           topology.getArticulationPoints(), topology.getBridges(), failures == before ? "ok" : "DIFFERENT");
+}
+
+int main() {
+    printf("%-24s %6s %6s %6s %6s %6s %6s %8s %8s\n", "maze", "cells", "parts", "loops", "dead", "chains", "junct", "artic", "bridges");
+    const MazeGenerator generators[] = {GENERATOR_PRIM, GENERATOR_ELLER, GENERATOR_KRUSKAL, GENERATOR_BACKTRACKER};
+    for(MazeGenerator g : generators) {
+        unique_ptr<Generator> generator(Maze::createGenerator(g));
+        for(uint64_t seed=1; seed<=3; seed++) {
+            Maze mazeClass(14, 17, seed, g);
+            mazeClass.generateMaze();
+            char name[32];
+            snprintf(name, sizeof(name), "%s seed %d", generator->getName(), (int)seed);
+            checkTopology(name, mazeClass.graph);
+
+            // a wall across the maze and a walled in cell split it into parts
+            for(int j=0; j<17; j++) {
+                mazeClass.grid[6][j].setWallDown(true);
+                mazeClass.grid[7][j].setWallUp(true);
+            }
+            mazeClass.addNeighbor(6, 3, 7, 3);
+            for(int j=0; j<17; j++) {
+                mazeClass.grid[9][j].setWallDown(true);
+                mazeClass.grid[10][j].setWallUp(true);
+            }
+            mazeClass.grid[12][5].closeAll();
+            mazeClass.grid[11][5].setWallDown(true);
+            mazeClass.grid[13][5].setWallUp(true);
+            mazeClass.grid[12][4].setWallRight(true);
+            mazeClass.grid[12][6].setWallLeft(true);
+            mazeClass.graph.build(mazeClass.grid);
+            snprintf(name, sizeof(name), "%s seed %d split", generator->getName(), (int)seed);
+            checkTopology(name, mazeClass.graph);
+        }
+    }
+
+    printf("\n%-10s %10s %12s %10s %10s %10s\n", "maze", "graph ms", "topology ms", "MB", "loops", "bridges");
+    for(int size : {500, 1000, 2000, 4096}) {
+        Maze mazeClass(size, size, 11, GENERATOR_TILED);
+        mazeClass.generateMaze();
+        Timer timer;
+        NavGraph graph;
+        graph.build(mazeClass.grid);
+        double graphMs = timer.elapsedMs();
+        timer.reset();
+        MazeTopology topology(graph);
+        double topologyMs = timer.elapsedMs();
+        if(topology.getComponents() != 1)
+            failures++;
+
+        char name[16];
+        snprintf(name, sizeof(name), "%dx%d", size, size);
+        printf("%-10s %10.1f %12.1f %10.1f %10lld %10lld\n", name, graphMs, topologyMs,
+               (double)topology.getMemoryBytes() / (1 << 20), topology.getLoops(), topology.getBridges());
+    }
+
+    if(failures != 0) {
+        printf("ERROR: %d differences between the topology and brute force\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+#ifndef OPENGLPRJ_ASTAR_H
+#define OPENGLPRJ_ASTAR_H
+#include <vector>
+#include <cstdlib>
+#include "NavGraph.h"
+#include "Landmarks.h"
+#include "PathFinder.h"
+using namespace std;
+
+// A* with the manhattan distance as heuristic
+// every step costs 1 and changes the manhattan distance by exactly 1, so f = g + h of a neighbor is either
+// the same as the current f or 2 more, which means two buckets are a complete priority queue:
+// the bucket being expanded and the next one
+// within a bucket the most recently added cell is expanded first, which follows corridors without detours
+// with landmarks the heuristic is also at least their lower bound (ALT), which keeps the same parity as the manhattan
+// distance on the grid, so the two buckets still work
+class AStar : public PathFinder {
+
+private:
+
+    const NavGraph* graph;
+    int V;
+    int cols;
+
+    // optional landmarks and their distances to the destination of the current search
+    const Landmarks* landmarks;
+    const int* destLandmarks;
+
+    // g and parent are only valid for cells stamped with the current search, closed cells are stamped separately
+    vector<int> g;
+    vector<int> parent;
+    vector<unsigned int> seen;
+    vector<unsigned int> closed;
+    unsigned int generation;
+
+    vector<int> current;
+    vector<int> following;
+
+    // number of cells expanded by the last search
+    int expanded;
+
+    int heuristic(int v, int dest) const {
+        int h = abs(v % cols - dest % cols) + abs(v / cols - dest / cols);
+        if(landmarks != nullptr) {
+            int bound = landmarks->lowerBound(v, destLandmarks);
+            if(bound > h)
+                h = bound;
+        }
+        return h;
+    }
+
+    bool search(int source, int dest) {
+        if(++generation == 0) {
+            seen.assign(V, 0);
+            closed.assign(V, 0);
+            generation = 1;
+        }
+        current.clear();
+        following.clear();
+        expanded = 0;
+        if(landmarks != nullptr)
+            destLandmarks = landmarks->distancesOf(dest);
+
+        g[source] = 0;
+        parent[source] = -1;
+        seen[source] = generation;
+        current.push_back(source);
+        int f = heuristic(source, dest);
+
+        while(true) {
+            if(current.empty()) {
+                if(following.empty())
+                    return false;
+                current.swap(following);
+                f += 2;
+            }
+
+            int v = current.back();
+            current.pop_back();
+
+            // skip cells that were added again later with a smaller g
+            if(closed[v] == generation || g[v] + heuristic(v, dest) != f)
+                continue;
+            closed[v] = generation;
+            expanded++;
+            if(v == dest)
+                return true;
+
+            int next = g[v] + 1;
+            for(int k: graph->neighborsOf(v)) {
+                if(seen[k] != generation || next < g[k]) {
+                    seen[k] = generation;
+                    g[k] = next;
+                    parent[k] = v;
+                    if(next + heuristic(k, dest) == f)
+                        current.push_back(k);
+                    else
+                        following.push_back(k);
+                }
+            }
+        }
+    }
+
+public:
+
+    AStar() : graph(nullptr), V(0), cols(0), landmarks(nullptr), destLandmarks(nullptr), generation(0), expanded(0) {}
+
+    // landmarks have to be computed on the same graph and outlive the search
+    explicit AStar(const NavGraph &graph, const Landmarks* landmarks = nullptr) : graph(&graph), V(graph.getV()), cols(graph.getCols()),
+            landmarks(landmarks), destLandmarks(nullptr), g(V), parent(V), seen(V, 0), closed(V, 0), generation(0), expanded(0) {
+        current.reserve(V);
+        following.reserve(V);
+    }
+
+    bool getPath(int source, int dest, vector<int> &path) override {
+        path.clear();
+        if(source == dest || !search(source, dest))
+            return false;
+
+        path.resize(g[dest]);
+        for(int v = dest, i = g[dest]; v != source; v = parent[v])
+            path[--i] = v;
+        return true;
+    }
+
+    // landmarks for the searches from the next one on, nullptr searches with the manhattan distance alone
+    void setLandmarks(const Landmarks* landmarks) {
+        this->landmarks = landmarks;
+    }
+
+    int getExpanded() const {
+        return expanded;
+    }
+
+    // the heuristic estimate from source to dest, the real distance is never smaller
+    int estimate(int source, int dest) {
+        if(landmarks != nullptr)
+            destLandmarks = landmarks->distancesOf(dest);
+        return heuristic(source, dest);
+    }
+
+    const char* getName() const override {
+        return landmarks != nullptr ? "ALT" : "A*";
+    }
+};
+
+#endif // OPENGLPRJ_ASTAR_H
@@ -0,0 +1,59 @@
+#ifndef OPENGLPRJ_BACKTRACKERGENERATOR_H
+#define OPENGLPRJ_BACKTRACKERGENERATOR_H
+#include <vector>
+#include "Generator.h"
+using namespace std;
+
+// recursive backtracker: a depth-first search that goes on to a random unvisited neighbor and backs up when there is none
+// the path to the current cell is an explicit stack, so a maze of any size can't overflow the call stack
+// makes a perfect maze with long winding corridors and few dead ends
+class BacktrackerGenerator : public Generator {
+private:
+    vector<int> stack;
+
+    size_t peakBytes;
+
+public:
+    BacktrackerGenerator() : peakBytes(0) {}
+
+    void carve(Grid &grid, Random &random) override {
+        int rows = grid.getRows(), cols = grid.getCols();
+        int V = rows * cols;
+
+        stack.clear();
+        int start = random.below(V);
+        grid.at(start).setVisited(true);
+        stack.push_back(start);
+        while(!stack.empty()) {
+            int v = stack.back();
+            int r = v / cols, c = v % cols;
+            int options[4], count = 0;
+            if(r > 0 && !grid.at(v - cols).isVisited()) options[count++] = v - cols;
+            if(r < rows - 1 && !grid.at(v + cols).isVisited()) options[count++] = v + cols;
+            if(c > 0 && !grid.at(v - 1).isVisited()) options[count++] = v - 1;
+            if(c < cols - 1 && !grid.at(v + 1).isVisited()) options[count++] = v + 1;
+            if(count == 0) {
+                stack.pop_back();
+                continue;
+            }
+            int next = options[random.below(count)];
+            openWall(grid, v, next);
+            grid.at(next).setVisited(true);
+            stack.push_back(next);
+        }
+
+        // the stack can grow to every cell of the maze on a long corridor
+        peakBytes = stack.capacity() * sizeof(int);
+        vector<int>().swap(stack);
+    }
+
+    size_t getPeakMemoryBytes() const override {
+        return peakBytes;
+    }
+
+    const char* getName() const override {
+        return "backtracker";
+    }
+};
+
+#endif // OPENGLPRJ_BACKTRACKERGENERATOR_H
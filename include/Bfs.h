@@ -2,73 +2,53 @@
 #define OPENGLPRJ_BFS_H
 #include <stack>
 #include "Maze.h"
+#include "NavGraph.h"
+#include "MazeTopology.h"
+#include "SearchWorkspace.h"
+#include "PathFinder.h"
 using namespace std;
 
-class BFS {
+class BFS : public PathFinder {
 
 private:
 
     // number of cells
     int V;
 
-    // adjacency List
-    vector<vector<int> > adj;
+    // graph of the maze, owned by Maze and shared by all ghosts
+    const NavGraph* graph;
 
-    // get max element from list
-    int maxElement(vector<int> list){
-        int max = 0;
-        for(int i=1;i<list.size();i++){
-            if(list[i] > list[max]){
-                max = i;
-            }
-        }
-        return max;
-    }
-
-    // checks if row and column are inside the maze
-    bool isValid(int row, int col){
-        return (row >= 0 && row < rows && col >= 0 && col < cols);
-    }
+    // visited marks, parents and queue reused by every search
+    SearchWorkspace workspace;
 
-    // add edge to cell
-    void addEdge(int v, int w){
-        adj[v].push_back(w);
-    }
+    // components of the maze if they are known, a search between two of them fails without visiting a cell
+    const MazeTopology* topology;
 
     // this function returns if destination is reachable or not
-    // additionally it sets the parent array to say the path (if exist)
-    bool Run_BFS(int source, int dest, int parent[]) {
+    // additionally it sets the parents in the workspace to say the path (if exist)
+    bool Run_BFS(int source, int dest) {
 
-        queue<int> q;
-        bool* visited = new bool[V];
-
-        // setting all the vertices as non-visited
-        // and parents of all vertices as -1.
-        for(int i=0; i<V; i++) {
-            visited[i] = false;
-            parent[i] = -1;
-        }
+        // setting all the vertices as non-visited, which only advances the generation
+        workspace.newSearch();
 
         // pushing the source into the queue and mark it as visited.
-        q.push(source);
-        visited[source] = true;
+        workspace.push(source);
+        workspace.visit(source, -1);
 
         // loop executes until all vertices are traversed.
-        while(!q.empty()) {
+        while(!workspace.empty()) {
 
             // popping one element from queue.
-            int temp = q.front();
-            q.pop();
+            int temp = workspace.pop();
 
             // check for all adjacent
-            for(int k: adj[temp]) {
-                if(visited[k] == false) {
+            for(int k: graph->neighborsOf(temp)) {
+                if(!workspace.isVisited(k)) {
 
                     // pushing into queue and mark it visited as well as
-                    // set the parent of the adjacent in parent array
-                    q.push(k);
-                    visited[k] = true;
-                    parent[k] = temp;
+                    // set the parent of the adjacent
+                    workspace.push(k);
+                    workspace.visit(k, temp);
 
                     // if destination is reached, returns true to indicate that a path exists
                     if(k == dest)
@@ -82,69 +62,83 @@ private:
     }
 
 public:
-    // use maze from Maze.h to initialize the adjacency list
-    BFS(){
-        this->V = rows*cols;
-        adj.resize(V);
-        for(int i=0;i<rows;i++){
-            for(int j=0;j<cols;j++){
-                if(isValid(i-1,j) && !maze[i][j].wallUp){
-                    addEdge(j+i*cols,j+(i-1)*cols);
-                }
-                if(isValid(i+1,j) && !maze[i][j].wallDown){
-                    addEdge(j+i*cols,j+(i+1)*cols);
-                }
-                if(isValid(i,j-1) && !maze[i][j].wallLeft){
-                    addEdge(j+i*cols,(j-1)+(i)*cols);
-                }
-                if(isValid(i,j+1) && !maze[i][j].wallRight){
-                    addEdge(j+i*cols,(j+1)+(i)*cols);
-                }
-            }
-        }
+    BFS() : V(0), graph(nullptr), topology(nullptr) {}
+
+    // search on the graph built by Maze::generateMaze(), nothing is copied
+    // the workspace is allocated here once, searches don't allocate
+    BFS(const NavGraph &graph, const MazeTopology* topology = nullptr) : workspace(graph.getV()) {
+        this->V = graph.getV();
+        this->graph = &graph;
+        this->topology = topology;
     }
 
-    // used by ghosts running from pacman
-    int getRunningPath(int src, int pacman){
-        int src_x = src % cols;
-        int src_z = src / cols;
-        int pac_x = pacman % cols;
-        int pac_z = pacman / cols;
-        vector<int> distances;
-        for(int cord : adj[src]){
-            int x = cord % cols;
-            int z = cord / cols;
-            int dist = glm::abs(pac_x - x) + glm::abs(pac_z - z);
-            distances.push_back(dist);
+    // function to get the shortest path, written into path without the source cell
+    // the vector is reused, so once it has grown to the longest path no more memory is allocated
+    bool getPath(int source, int dest, vector<int> &path) override {
+
+        path.clear();
+
+        // a cell in another component would only be found not to be there after the whole component is searched
+        if(topology != nullptr && !topology->isConnected(source, dest))
+            return false;
+
+        // BFS returns false means destination is not reachable, return empty path
+        if(Run_BFS(source, dest) == false) {
+            return false;
         }
-        int next = adj[src][maxElement(distances)];
-        if(distances[maxElement(distances)] <= glm::abs(pac_x - src_x)+glm::abs(pac_z - src_z))
-            return src;
-        return next;
-    }
 
-    // function to get the shortest path
-    vector<int> getPath(int source, int dest) {
+        // count the cells on the path, then trace it back from the end
+        int length = 0;
+        for(int v = dest; v != source; v = workspace.getParent(v))
+            length++;
 
-        // it stores parent for each vertex to trace the path
-        int* parent = new int[V];
+        path.resize(length);
+        for(int v = dest; v != source; v = workspace.getParent(v))
+            path[--length] = v;
 
-        vector<int> path;
+        return true;
+    }
 
-        // BFS returns false means destination is not reachable, return empty path
-        if(Run_BFS(source, dest, parent) == false) {
-            return path;
+    // next cell towards target for each of count source cells, written to next (-1 if a source is the target or can't reach it)
+    // one search from the target answers all of them: the parent of a cell is its next step,
+    // and the search stops as soon as every source has been reached
+    void getNextCells(const int* sources, int count, int target, int* next) {
+        workspace.newSearch();
+        int remaining = 0;
+        for(int i=0; i<count; i++) {
+            if(sources[i] != target && !workspace.isMarked(sources[i])) {
+                workspace.mark(sources[i]);
+                remaining++;
+            }
         }
 
-        // tracing the path
-        while(parent[dest] != -1) {
-            // Add to the front of the list
-            path.insert(path.begin(), dest);
-            dest = parent[dest];
+        workspace.push(target);
+        workspace.visit(target, -1);
+        while(remaining > 0 && !workspace.empty()) {
+            int temp = workspace.pop();
+            for(int k: graph->neighborsOf(temp)) {
+                if(!workspace.isVisited(k)) {
+                    workspace.push(k);
+                    workspace.visit(k, temp);
+                    if(workspace.isMarked(k))
+                        remaining--;
+                }
+            }
         }
 
+        for(int i=0; i<count; i++)
+            next[i] = workspace.isVisited(sources[i]) ? workspace.getParent(sources[i]) : -1;
+    }
+
+    vector<int> getPath(int source, int dest) {
+        vector<int> path;
+        getPath(source, dest, path);
         return path;
     }
+
+    const char* getName() const override {
+        return "BFS";
+    }
 };
 
 #endif // OPENGLPRJ_BFS_H
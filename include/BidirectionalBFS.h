@@ -0,0 +1,131 @@
+#ifndef OPENGLPRJ_BIDIRECTIONALBFS_H
+#define OPENGLPRJ_BIDIRECTIONALBFS_H
+#include <vector>
+#include "NavGraph.h"
+#include "PathFinder.h"
+using namespace std;
+
+// BFS from both ends at once, one whole layer at a time, always growing the side with the smaller frontier
+// the two searches together visit about two balls of half the radius instead of one of the full radius
+// when a layer touches the other side the layer is finished and the meeting cell with the shortest total is used,
+// stopping at the first touch could give a path one step too long
+class BidirectionalBFS : public PathFinder {
+
+private:
+
+    const NavGraph* graph;
+    int V;
+
+    // side 0 searches from the source, side 1 from the destination
+    // distance and parent are only valid for cells stamped with the current search on that side
+    vector<int> distance[2];
+    vector<int> parent[2];
+    vector<unsigned int> seen[2];
+    unsigned int generation;
+
+    vector<int> frontier[2];
+    vector<int> next;
+
+    // number of cells visited by the last search on both sides
+    int visited;
+
+    bool isSeen(int side, int v) const {
+        return seen[side][v] == generation;
+    }
+
+    void visit(int side, int v, int from, int dist) {
+        seen[side][v] = generation;
+        parent[side][v] = from;
+        distance[side][v] = dist;
+        visited++;
+    }
+
+    // expand one layer of a side, returns the best meeting cell found in it or -1
+    int expand(int side) {
+        int other = side ^ 1;
+        int meeting = -1, best = 0;
+        next.clear();
+        for(int v: frontier[side]) {
+            int dist = distance[side][v] + 1;
+            for(int k: graph->neighborsOf(v)) {
+                if(isSeen(side, k))
+                    continue;
+                visit(side, k, v, dist);
+                next.push_back(k);
+                if(isSeen(other, k) && (meeting == -1 || dist + distance[other][k] < best)) {
+                    meeting = k;
+                    best = dist + distance[other][k];
+                }
+            }
+        }
+        frontier[side].swap(next);
+        return meeting;
+    }
+
+    int search(int source, int dest) {
+        if(++generation == 0) {
+            seen[0].assign(V, 0);
+            seen[1].assign(V, 0);
+            generation = 1;
+        }
+        visited = 0;
+        frontier[0].clear();
+        frontier[1].clear();
+        visit(0, source, -1, 0);
+        visit(1, dest, -1, 0);
+        frontier[0].push_back(source);
+        frontier[1].push_back(dest);
+
+        while(!frontier[0].empty() && !frontier[1].empty()) {
+            int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+            int meeting = expand(side);
+            if(meeting != -1)
+                return meeting;
+        }
+        return -1;
+    }
+
+public:
+
+    BidirectionalBFS() : graph(nullptr), V(0), generation(0), visited(0) {}
+
+    explicit BidirectionalBFS(const NavGraph &graph) : graph(&graph), V(graph.getV()), generation(0), visited(0) {
+        for(int side=0; side<2; side++) {
+            distance[side].assign(V, 0);
+            parent[side].assign(V, -1);
+            seen[side].assign(V, 0);
+            frontier[side].reserve(V);
+        }
+        next.reserve(V);
+    }
+
+    bool getPath(int source, int dest, vector<int> &path) override {
+        path.clear();
+        if(source == dest)
+            return false;
+        int meeting = search(source, dest);
+        if(meeting == -1)
+            return false;
+
+        // source half back to front, then the destination half in order
+        int length = distance[0][meeting] + distance[1][meeting];
+        path.resize(length);
+        int i = distance[0][meeting];
+        for(int v = meeting; v != source; v = parent[0][v])
+            path[--i] = v;
+        i = distance[0][meeting];
+        for(int v = parent[1][meeting]; v != -1; v = parent[1][v])
+            path[i++] = v;
+        return true;
+    }
+
+    int getVisited() const {
+        return visited;
+    }
+
+    const char* getName() const override {
+        return "bidirectional BFS";
+    }
+};
+
+#endif // OPENGLPRJ_BIDIRECTIONALBFS_H
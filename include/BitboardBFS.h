@@ -0,0 +1,306 @@
+#ifndef OPENGLPRJ_BITBOARDBFS_H
+#define OPENGLPRJ_BITBOARDBFS_H
+#include <vector>
+#include <cstdint>
+#include "NavGraph.h"
+#include "PathFinder.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace std;
+
+// BFS that expands a whole layer at once on bitboards
+// every row of the maze is a row of 64 bit words with one bit per cell, passages are stored as two bitboards:
+// east (cell can go to the cell on its right) and south (cell can go to the cell below it)
+// a layer is the frontier shifted left, right, up and down, masked by the passages and by the visited cells,
+// which is a handful of word operations for up to 64 cells instead of one step per cell
+// dense layers sweep whole rows, with AVX2 when the compiler targets it (-mavx2 or /arch:AVX2),
+// sparse layers (long maze corridors) only expand the words around the frontier
+class BitboardBFS : public PathFinder {
+
+private:
+
+    int V;
+    int rows;
+    int cols;
+
+    // words per row, rounded up to a multiple of 4 so the AVX2 loop never needs a tail
+    int stride;
+
+    vector<uint64_t> east;
+    vector<uint64_t> south;
+
+    // bitboards of one search
+    vector<uint64_t> visited;
+    vector<uint64_t> frontier;
+    vector<uint64_t> next;
+
+    // distance of every visited cell from the source of the last search
+    vector<int> distance;
+
+    // frontier words of the current and the next layer, and a stamp per word so a word is expanded once per layer
+    vector<size_t> active;
+    vector<size_t> activeNext;
+    vector<unsigned int> wordMark;
+    unsigned int generation;
+
+    static int countTrailingZeros(uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return (int)index;
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    bool isSet(const vector<uint64_t> &board, int v) const {
+        int r = v / cols, c = v % cols;
+        return (board[(size_t)r * stride + (c >> 6)] >> (c & 63)) & 1;
+    }
+
+    void set(vector<uint64_t> &board, int v) {
+        int r = v / cols, c = v % cols;
+        board[(size_t)r * stride + (c >> 6)] |= (uint64_t)1 << (c & 63);
+    }
+
+    // new cells of word w in row r reached from the frontier, also marks them as visited
+    uint64_t expandWord(int r, int w) {
+        size_t i = (size_t)r * stride + w;
+        uint64_t f = frontier[i];
+
+        // east: cells that can go right shifted one bit up, plus the top bit of the previous word
+        uint64_t reached = (f & east[i]) << 1;
+        if(w > 0)
+            reached |= (frontier[i-1] & east[i-1]) >> 63;
+
+        // west: the frontier shifted one bit down with the lowest bit of the next word, masked by the east passage of the target cell
+        uint64_t following = w + 1 < stride ? frontier[i+1] : 0;
+        reached |= ((f >> 1) | (following << 63)) & east[i];
+
+        // south from the row above and north from the row below
+        if(r > 0)
+            reached |= frontier[i-stride] & south[i-stride];
+        if(r < rows-1)
+            reached |= frontier[i+stride] & south[i];
+
+        reached &= ~visited[i];
+        next[i] = reached;
+        visited[i] |= reached;
+        return reached;
+    }
+
+    // expand a whole row, used when the frontier is dense
+    void expandRow(int r) {
+#ifdef __AVX2__
+        const uint64_t* f = &frontier[(size_t)r * stride];
+        const uint64_t* e = &east[(size_t)r * stride];
+        const uint64_t* above = r > 0 ? &frontier[(size_t)(r-1) * stride] : nullptr;
+        const uint64_t* aboveSouth = r > 0 ? &south[(size_t)(r-1) * stride] : nullptr;
+        const uint64_t* below = r < rows-1 ? &frontier[(size_t)(r+1) * stride] : nullptr;
+        const uint64_t* s = &south[(size_t)r * stride];
+        uint64_t* vis = &visited[(size_t)r * stride];
+        uint64_t* out = &next[(size_t)r * stride];
+        uint64_t carry = 0;
+
+        for(int w = 0; w < stride; w += 4) {
+            __m256i fv = _mm256_loadu_si256((const __m256i*)(f + w));
+            __m256i ev = _mm256_loadu_si256((const __m256i*)(e + w));
+
+            // east, the top bit of every lane moves into the next lane and the last one into the next block
+            __m256i moving = _mm256_and_si256(fv, ev);
+            __m256i carries = _mm256_permute4x64_epi64(_mm256_srli_epi64(moving, 63), _MM_SHUFFLE(2, 1, 0, 3));
+            carries = _mm256_blend_epi32(carries, _mm256_set_epi64x(0, 0, 0, (long long)carry), 0x03);
+            __m256i reached = _mm256_or_si256(_mm256_slli_epi64(moving, 1), carries);
+            carry = (uint64_t)_mm256_extract_epi64(moving, 3) >> 63;
+
+            // west, the lowest bit of every lane moves into the previous lane and the next block's into the last one
+            uint64_t following = w + 4 < stride ? f[w + 4] : 0;
+            __m256i borrows = _mm256_permute4x64_epi64(_mm256_slli_epi64(fv, 63), _MM_SHUFFLE(0, 3, 2, 1));
+            borrows = _mm256_blend_epi32(borrows, _mm256_set_epi64x((long long)(following << 63), 0, 0, 0), 0xC0);
+            reached = _mm256_or_si256(reached, _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(fv, 1), borrows), ev));
+
+            // south and north
+            if(above != nullptr)
+                reached = _mm256_or_si256(reached, _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(above + w)), _mm256_loadu_si256((const __m256i*)(aboveSouth + w))));
+            if(below != nullptr)
+                reached = _mm256_or_si256(reached, _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(below + w)), _mm256_loadu_si256((const __m256i*)(s + w))));
+
+            __m256i visv = _mm256_loadu_si256((const __m256i*)(vis + w));
+            reached = _mm256_andnot_si256(visv, reached);
+            _mm256_storeu_si256((__m256i*)(out + w), reached);
+            _mm256_storeu_si256((__m256i*)(vis + w), _mm256_or_si256(visv, reached));
+        }
+#else
+        for(int w = 0; w < stride; w++)
+            expandWord(r, w);
+#endif
+    }
+
+    // write the distance of every cell in a new frontier word and remember the word for the next layer
+    // returns true if stop is one of them
+    bool collect(size_t i, int layer, int stop) {
+        uint64_t bits = next[i];
+        if(bits == 0)
+            return false;
+        activeNext.push_back(i);
+        int base = (int)(i / stride) * cols + (int)(i % stride) * 64;
+        bool found = false;
+        while(bits != 0) {
+            int cell = base + countTrailingZeros(bits);
+            distance[cell] = layer;
+            found |= cell == stop;
+            bits &= bits - 1;
+        }
+        return found;
+    }
+
+    // flood from source one layer at a time until stop is reached (or everything if stop is -1)
+    // a layer only looks at the frontier words and the words next to them, unless the frontier is so dense
+    // that sweeping its rows is cheaper
+    void flood(int source, int stop) {
+        visited.assign(visited.size(), 0);
+        frontier.assign(frontier.size(), 0);
+        set(visited, source);
+        set(frontier, source);
+        distance[source] = 0;
+        active.clear();
+        active.push_back((size_t)(source / cols) * stride + (source % cols) / 64);
+
+        int words = (cols + 63) / 64;
+        for(int layer = 1; !active.empty(); layer++) {
+            activeNext.clear();
+            bool found = false;
+
+            int low = rows, high = -1;
+            for(size_t a : active) {
+                int r = (int)(a / stride);
+                if(r < low) low = r;
+                if(r > high) high = r;
+            }
+            int from = low > 0 ? low - 1 : 0;
+            int to = high < rows-1 ? high + 1 : rows-1;
+
+            if(active.size() * 5 >= (size_t)(to - from + 1) * stride) {
+                for(int r = from; r <= to; r++)
+                    expandRow(r);
+                for(int r = from; r <= to; r++)
+                    for(int w = 0; w < words; w++)
+                        found |= collect((size_t)r * stride + w, layer, stop);
+            }else{
+                if(++generation == 0) {
+                    wordMark.assign(wordMark.size(), 0);
+                    generation = 1;
+                }
+                for(size_t a : active) {
+                    int r = (int)(a / stride), w = (int)(a % stride);
+                    int candidates[5][2] = {{r, w}, {r, w-1}, {r, w+1}, {r-1, w}, {r+1, w}};
+                    for(int c = 0; c < 5; c++) {
+                        int cr = candidates[c][0], cw = candidates[c][1];
+                        if(cr < 0 || cr >= rows || cw < 0 || cw >= words)
+                            continue;
+                        size_t i = (size_t)cr * stride + cw;
+                        if(wordMark[i] == generation)
+                            continue;
+                        wordMark[i] = generation;
+                        if(expandWord(cr, cw) != 0)
+                            found |= collect(i, layer, stop);
+                    }
+                }
+            }
+
+            // the new cells become the frontier, the old frontier words are cleared
+            frontier.swap(next);
+            for(size_t a : active)
+                next[a] = 0;
+            active.swap(activeNext);
+            if(found)
+                break;
+        }
+
+        // leave next empty for the following search
+        for(size_t a : active)
+            frontier[a] = 0;
+    }
+
+public:
+
+    static const int unreachable = -1;
+
+    BitboardBFS() : V(0), rows(0), cols(0), stride(0), generation(0) {}
+
+    explicit BitboardBFS(const NavGraph &graph) : V(graph.getV()), rows(graph.getRows()), cols(graph.getCols()), generation(0) {
+        stride = ((cols + 63) / 64 + 3) / 4 * 4;
+        size_t words = (size_t)rows * stride;
+        east.assign(words, 0);
+        south.assign(words, 0);
+        visited.assign(words, 0);
+        frontier.assign(words, 0);
+        next.assign(words, 0);
+        distance.assign(V, 0);
+        wordMark.assign(words, 0);
+
+        for(int v=0; v<V; v++) {
+            for(int k: graph.neighborsOf(v)) {
+                if(k == v + 1) set(east, v);
+                if(k == v + cols) set(south, v);
+            }
+        }
+    }
+
+    // distances from source to every cell, read them with getDistance
+    void computeDistances(int source) {
+        flood(source, -1);
+    }
+
+    // distance from the source of the last search, or unreachable
+    // after getPath only cells up to the destination's distance are known
+    int getDistance(int cell) const {
+        return isSet(visited, cell) ? distance[cell] : unreachable;
+    }
+
+    // same as BFS::getPath: the shortest path from source to dest without the source cell
+    // the search floods from dest, then the path is walked from source down the distances
+    bool getPath(int source, int dest, vector<int> &path) override {
+        path.clear();
+        if(source == dest)
+            return false;
+
+        flood(dest, source);
+        if(!isSet(visited, source))
+            return false;
+
+        int v = source;
+        path.resize(distance[source]);
+        for(int i = 0; v != dest; i++) {
+            int dist = distance[v];
+            int candidates[4] = {v - cols, v + cols, v - 1, v + 1};
+            bool open[4] = {v >= cols && isSet(south, v - cols), v + cols < V && isSet(south, v),
+                            v % cols > 0 && isSet(east, v - 1), isSet(east, v)};
+            for(int d=0; d<4; d++) {
+                int k = candidates[d];
+                if(open[d] && isSet(visited, k) && distance[k] == dist - 1) {
+                    v = k;
+                    break;
+                }
+            }
+            path[i] = v;
+        }
+        return true;
+    }
+
+    vector<int> getPath(int source, int dest) {
+        vector<int> path;
+        getPath(source, dest, path);
+        return path;
+    }
+
+    const char* getName() const override {
+        return "bitboard BFS";
+    }
+};
+
+#endif // OPENGLPRJ_BITBOARDBFS_H
@@ -1,10 +1,58 @@
 #ifndef UNTITLED2_CELL_H
 #define UNTITLED2_CELL_H
 
+// one cell of the maze packed in a single byte: four wall bits, coin, powerup and visited
+// the row and column aren't stored, they follow from the cell's place in the Grid
 class Cell{
 public:
-    int row, col;
-    bool wallUp, wallDown, wallLeft, wallRight, hasCoin, hasPowerup, visited;
+    // the bit of each flag, for code that stores cells in another packed form (level files)
+    enum Bits {
+        WALL_UP = 1,
+        WALL_DOWN = 2,
+        WALL_LEFT = 4,
+        WALL_RIGHT = 8,
+        COIN = 16,
+        POWERUP = 32,
+        VISITED = 64
+    };
+
+private:
+    unsigned char bits;
+
+    bool get(unsigned char mask) const {
+        return (bits & mask) != 0;
+    }
+
+    void set(unsigned char mask, bool on) {
+        bits = on ? (bits | mask) : (bits & ~mask);
+    }
+
+public:
+    Cell() : bits(0) {}
+
+    bool wallUp() const { return get(WALL_UP); }
+    bool wallDown() const { return get(WALL_DOWN); }
+    bool wallLeft() const { return get(WALL_LEFT); }
+    bool wallRight() const { return get(WALL_RIGHT); }
+    bool hasCoin() const { return get(COIN); }
+    bool hasPowerup() const { return get(POWERUP); }
+    bool isVisited() const { return get(VISITED); }
+
+    void setWallUp(bool on) { set(WALL_UP, on); }
+    void setWallDown(bool on) { set(WALL_DOWN, on); }
+    void setWallLeft(bool on) { set(WALL_LEFT, on); }
+    void setWallRight(bool on) { set(WALL_RIGHT, on); }
+    void setCoin(bool on) { set(COIN, on); }
+    void setPowerup(bool on) { set(POWERUP, on); }
+    void setVisited(bool on) { set(VISITED, on); }
+
+    unsigned char getBits() const { return bits; }
+    void setBits(unsigned char newBits) { bits = newBits; }
+
+    // walls on all four sides and nothing else, how every cell starts before the maze is carved
+    void closeAll() {
+        bits = WALL_UP | WALL_DOWN | WALL_LEFT | WALL_RIGHT;
+    }
 };
 
 #endif // UNTITLED2_CELL_H
@@ -0,0 +1,261 @@
+#ifndef OPENGLPRJ_COOPERATIVEPLANNER_H
+#define OPENGLPRJ_COOPERATIVEPLANNER_H
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "NavGraph.h"
+#include "FlowField.h"
+using namespace std;
+
+// cooperative paths for many ghosts chasing the same target (windowed hierarchical cooperative A*)
+// ghosts plan one after another for the next window ticks, every planned step reserves its (cell, tick) in a table,
+// and later ghosts plan around the reservations, so they wait or take other routes instead of stacking on one cell
+// the flow field gives the exact remaining distance to the target, which is the heuristic of the space-time search
+// plans are redone every window/2 ticks with a rotating order, or earlier when a ghost is not where its plan says,
+// a target that moves in between only changes the heuristic a little, so it doesn't trigger a new plan
+// cells are numbered like in Ghost, x + z*cols
+class CooperativePlanner {
+
+private:
+
+    // open addressing hash table from (cell, tick) to an owner, emptied in O(1) with a generation stamp
+    class SpaceTimeTable {
+    private:
+        vector<uint64_t> keys;
+        vector<int> values;
+        vector<unsigned int> stamps;
+        unsigned int generation;
+        size_t mask;
+
+        size_t slot(uint64_t key) const {
+            return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+        }
+
+    public:
+        SpaceTimeTable() : generation(1), mask(0) {}
+
+        // room for about entries keys
+        void resize(size_t entries) {
+            size_t capacity = 16;
+            while(capacity < entries * 2)
+                capacity *= 2;
+            keys.assign(capacity, 0);
+            values.assign(capacity, -1);
+            stamps.assign(capacity, 0);
+            generation = 1;
+            mask = capacity - 1;
+        }
+
+        void clear() {
+            if(++generation == 0) {
+                stamps.assign(stamps.size(), 0);
+                generation = 1;
+            }
+        }
+
+        // set the value of a key, returns false if the table is full
+        bool put(uint64_t key, int value) {
+            for(size_t i = slot(key), probes = 0; probes <= mask; i = (i + 1) & mask, probes++) {
+                if(stamps[i] != generation || keys[i] == key) {
+                    stamps[i] = generation;
+                    keys[i] = key;
+                    values[i] = value;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // value of a key, or -1 if it isn't in the table
+        int get(uint64_t key) const {
+            for(size_t i = slot(key); stamps[i] == generation; i = (i + 1) & mask)
+                if(keys[i] == key)
+                    return values[i];
+            return -1;
+        }
+    };
+
+    // state of the space-time search
+    struct Node {
+        int cell;
+        int tick;
+        int g;
+        int parent;
+    };
+
+    const NavGraph* graph;
+    int V;
+    int window;
+
+    // cells of each ghost's plan for ticks 0..window, plan[ghost*(window+1) + tick]
+    vector<int> plans;
+    int ghosts;
+    int tick;
+    int round;
+    int target;
+
+    // order in which the ghosts plan, by distance to the target
+    vector<pair<int, int> > order;
+
+    SpaceTimeTable reservations;
+    SpaceTimeTable visited;
+    vector<Node> nodes;
+    vector<pair<int, int> > open;
+
+    // searches that couldn't plan the whole window
+    int blocked;
+    int replans;
+
+    // the largest number of states one ghost may expand, keeps a round bounded
+    int budget() const {
+        return 64 * (window + 1);
+    }
+
+    // order of the open states: lowest f first, and of equal f the one furthest in time
+    int priority(int t, int f) const {
+        return f * (window + 1) + (window - t);
+    }
+
+    uint64_t key(int cell, int t) const {
+        return (uint64_t)t * V + cell;
+    }
+
+    // can the ghost owner go from cell to next between tick t and t+1
+    bool isFree(int owner, int cell, int next, int t) const {
+        int other = reservations.get(key(next, t + 1));
+        if(other != -1 && other != owner)
+            return false;
+        // two ghosts can't swap cells through the same passage
+        int coming = reservations.get(key(cell, t + 1));
+        return coming == -1 || coming == owner || reservations.get(key(next, t)) != coming;
+    }
+
+    // space-time A* for one ghost from start at tick 0 until the end of the window or the target
+    void planGhost(int owner, int start, const FlowField &field) {
+        int* plan = &plans[(size_t)owner * (window + 1)];
+        if(field.getDistance(start) == FlowField::unreachable) {
+            for(int t = 0; t <= window; t++)
+                plan[t] = start;
+            return;
+        }
+
+        visited.clear();
+        nodes.clear();
+        open.clear();
+        Node first = {start, 0, 0, -1};
+        nodes.push_back(first);
+        visited.put(key(start, 0), 0);
+        open.push_back(make_pair(priority(0, field.getDistance(start)), 0));
+
+        // if the end of the window can't be reached the ghost follows the plan that gets furthest and then stays,
+        // which is the only case where it can still run into another ghost
+        int goal = 0;
+        bool complete = false;
+        while(!open.empty() && (int)nodes.size() < budget()) {
+            pop_heap(open.begin(), open.end(), greater<pair<int, int> >());
+            int index = open.back().second;
+            open.pop_back();
+            Node node = nodes[index];
+            if(node.tick > nodes[goal].tick)
+                goal = index;
+            if(node.tick == window || node.cell == target) {
+                complete = true;
+                break;
+            }
+
+            // moves to the neighbors and waiting on the same cell, all cost one tick
+            NavGraph::Neighbors neighbors = graph->neighborsOf(node.cell);
+            for(int m = -1; m < neighbors.size(); m++) {
+                int next = m == -1 ? node.cell : neighbors.begin()[m];
+                if(!isFree(owner, node.cell, next, node.tick))
+                    continue;
+                uint64_t k = key(next, node.tick + 1);
+                if(visited.get(k) != -1)
+                    continue;
+                Node child = {next, node.tick + 1, node.g + 1, index};
+                visited.put(k, nodes.size());
+                nodes.push_back(child);
+                open.push_back(make_pair(priority(child.tick, child.g + field.getDistance(next)), (int)nodes.size() - 1));
+                push_heap(open.begin(), open.end(), greater<pair<int, int> >());
+            }
+        }
+
+        // cells up to the tick the goal was reached, then the ghost stays there
+        int reached = nodes[goal].tick;
+        for(int i = goal; i != -1; i = nodes[i].parent)
+            plan[nodes[i].tick] = nodes[i].cell;
+        for(int t = reached + 1; t <= window; t++)
+            plan[t] = plan[reached];
+        if(!complete)
+            blocked++;
+        // the stay after a partial plan doesn't take cells other ghosts already planned to pass
+        for(int t = 0; t <= window; t++)
+            if(t <= reached || reservations.get(key(plan[t], t)) == -1)
+                reservations.put(key(plan[t], t), owner);
+    }
+
+    void replan(const int* cells, const FlowField &field) {
+        reservations.clear();
+        // every ghost keeps its current cell at tick 0
+        for(int i = 0; i < ghosts; i++)
+            reservations.put(key(cells[i], 0), i);
+        // ghosts closest to the target plan first, so the ones behind them follow instead of running into them
+        order.clear();
+        for(int i = 0; i < ghosts; i++) {
+            int owner = (round + i) % ghosts;
+            order.push_back(make_pair(field.getDistance(cells[owner]), owner));
+        }
+        stable_sort(order.begin(), order.end());
+        for(int i = 0; i < ghosts; i++)
+            planGhost(order[i].second, cells[order[i].second], field);
+        tick = 0;
+        round++;
+        replans++;
+    }
+
+public:
+
+    CooperativePlanner() : graph(nullptr), V(0), window(0), ghosts(0), tick(0), round(0), target(-1), blocked(0), replans(0) {}
+
+    explicit CooperativePlanner(const NavGraph &graph, int window = 16) : graph(&graph), V(graph.getV()), window(window),
+            ghosts(0), tick(0), round(0), target(-1), blocked(0), replans(0) {}
+
+    // next cell for each ghost for one tick, the ghosts have to be given in the same order every tick
+    // field has to hold the distances to target, a ghost that should wait gets its own cell
+    void getNextCells(const int* cells, int count, const FlowField &field, int* next) {
+        bool outdated = count != ghosts || tick >= window / 2;
+        if(count != ghosts) {
+            ghosts = count;
+            plans.assign((size_t)count * (window + 1), -1);
+            reservations.resize((size_t)count * (window + 1));
+            visited.resize(budget() * 5);
+            nodes.reserve(budget() * 5);
+            open.reserve(budget() * 5);
+        }
+        for(int i = 0; i < count && !outdated; i++)
+            outdated = plans[(size_t)i * (window + 1) + tick] != cells[i];
+
+        if(outdated) {
+            target = field.getTarget();
+            replan(cells, field);
+        }
+        for(int i = 0; i < count; i++)
+            next[i] = plans[(size_t)i * (window + 1) + tick + 1];
+        tick++;
+    }
+
+    int getWindow() const {
+        return window;
+    }
+
+    int getReplans() const {
+        return replans;
+    }
+
+    int getBlocked() const {
+        return blocked;
+    }
+};
+
+#endif // OPENGLPRJ_COOPERATIVEPLANNER_H
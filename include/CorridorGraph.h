@@ -0,0 +1,387 @@
+#ifndef OPENGLPRJ_CORRIDORGRAPH_H
+#define OPENGLPRJ_CORRIDORGRAPH_H
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <climits>
+#include <cstdlib>
+#include "NavGraph.h"
+#include "PathFinder.h"
+using namespace std;
+
+// navigation graph with the corridors contracted
+// cells with two passages are corridor cells, all other cells (junctions and dead ends) are nodes,
+// and the corridor between two nodes becomes one edge weighted with its length
+// a loop made only of corridor cells gets one of its cells as a node
+// it is only read by the searches, so the CorridorGraph engines of several threads share one
+class CorridorMap {
+
+    friend class CorridorGraph;
+
+private:
+
+    const NavGraph* graph;
+    int V;
+    int cols;
+
+    // node of each cell, -1 for corridor cells
+    vector<int> nodeOf;
+    vector<int> nodeCell;
+
+    // corridor and position along it of each corridor cell, -1 for nodes
+    vector<int> corridorOf;
+    vector<int> positionOf;
+
+    // cells of corridor c in order are corridorCells[corridorOffsets[c]] .. corridorCells[corridorOffsets[c+1]-1],
+    // it goes from node corridorEnds[2*c] to node corridorEnds[2*c+1]
+    vector<int> corridorOffsets;
+    vector<int> corridorCells;
+    vector<int> corridorEnds;
+
+    // edges between nodes in compressed sparse row form, each one follows a corridor
+    vector<int> edgeOffsets;
+    vector<int> edgeTarget;
+    vector<int> edgeCorridor;
+
+    int corridorLength(int c) const {
+        return corridorOffsets[c + 1] - corridorOffsets[c];
+    }
+
+    int heuristic(int cell, int dest) const {
+        return abs(cell % cols - dest % cols) + abs(cell / cols - dest / cols);
+    }
+
+    // follow the corridor that leaves node u through cell first and record it, unless it is known already
+    void traceCorridor(int u, int first) {
+        if(nodeOf[first] == -1 && corridorOf[first] != -1)
+            return;
+        if(nodeOf[first] != -1 && nodeOf[first] < u)
+            return;
+
+        int c = corridorEnds.size() / 2;
+        int previous = nodeCell[u], current = first;
+        while(nodeOf[current] == -1) {
+            corridorOf[current] = c;
+            positionOf[current] = corridorCells.size() - corridorOffsets[c];
+            corridorCells.push_back(current);
+            NavGraph::Neighbors neighbors = graph->neighborsOf(current);
+            int next = neighbors.begin()[0] == previous ? neighbors.begin()[1] : neighbors.begin()[0];
+            previous = current;
+            current = next;
+        }
+        corridorEnds.push_back(u);
+        corridorEnds.push_back(nodeOf[current]);
+        corridorOffsets.push_back(corridorCells.size());
+    }
+
+    void addNode(int v) {
+        nodeOf[v] = nodeCell.size();
+        nodeCell.push_back(v);
+    }
+
+    // append the cells of corridor c from position from to position to, both included, in either direction
+    void appendCorridor(int c, int from, int to, vector<int> &path) const {
+        const int* cells = &corridorCells[corridorOffsets[c]];
+        if(from <= to) {
+            for(int p = from; p <= to; p++)
+                path.push_back(cells[p]);
+        }else{
+            for(int p = from; p >= to; p--)
+                path.push_back(cells[p]);
+        }
+    }
+
+public:
+
+    explicit CorridorMap(const NavGraph &graph) : graph(&graph), V(graph.getV()), cols(graph.getCols()), nodeOf(V, -1),
+            corridorOf(V, -1), positionOf(V, -1) {
+        for(int v = 0; v < V; v++)
+            if(graph.degree(v) != 2)
+                addNode(v);
+
+        corridorOffsets.push_back(0);
+        int nodes = nodeCell.size();
+        for(int u = 0; u < nodes; u++)
+            for(int k: graph.neighborsOf(nodeCell[u]))
+                traceCorridor(u, k);
+
+        // loops without junctions, one of their cells becomes a node
+        for(int v = 0; v < V; v++) {
+            if(nodeOf[v] == -1 && corridorOf[v] == -1) {
+                addNode(v);
+                traceCorridor(nodeOf[v], graph.neighborsOf(v).begin()[0]);
+            }
+        }
+
+        // every corridor is an edge in both directions, except loops that come back to the same node
+        nodes = nodeCell.size();
+        int corridors = corridorEnds.size() / 2;
+        edgeOffsets.assign(nodes + 1, 0);
+        for(int c = 0; c < corridors; c++) {
+            if(corridorEnds[2 * c] != corridorEnds[2 * c + 1]) {
+                edgeOffsets[corridorEnds[2 * c] + 1]++;
+                edgeOffsets[corridorEnds[2 * c + 1] + 1]++;
+            }
+        }
+        for(int n = 0; n < nodes; n++)
+            edgeOffsets[n + 1] += edgeOffsets[n];
+        edgeTarget.resize(edgeOffsets[nodes]);
+        edgeCorridor.resize(edgeOffsets[nodes]);
+        vector<int> fill(edgeOffsets.begin(), edgeOffsets.end() - 1);
+        for(int c = 0; c < corridors; c++) {
+            int a = corridorEnds[2 * c], b = corridorEnds[2 * c + 1];
+            if(a == b)
+                continue;
+            edgeTarget[fill[a]] = b;
+            edgeCorridor[fill[a]++] = c;
+            edgeTarget[fill[b]] = a;
+            edgeCorridor[fill[b]++] = c;
+        }
+    }
+
+    // true for cells with exactly two passages, where a ghost can only go on or back
+    bool isCorridor(int cell) const {
+        return nodeOf[cell] == -1;
+    }
+
+    int getNodes() const {
+        return nodeCell.size();
+    }
+
+    int getEdges() const {
+        return edgeTarget.size() / 2;
+    }
+};
+
+// search on the nodes of a CorridorMap, the corridor cells are filled in when the path is written
+// the engine owns only its search buffers when the map is shared
+class CorridorGraph : public PathFinder {
+
+private:
+
+    // the map built by this engine, empty if it searches a shared one
+    unique_ptr<CorridorMap> ownMap;
+    const CorridorMap* map;
+
+    // search on the nodes, g and the parents are only valid for nodes stamped with the current search
+    // parentEdge is the edge used to reach a node, or one of the start values below
+    enum Start { FROM_SOURCE = -1, FROM_FRONT = -2, FROM_BACK = -3 };
+    vector<int> g;
+    vector<int> parentNode;
+    vector<int> parentEdge;
+    vector<unsigned int> seen;
+    vector<unsigned int> closed;
+    unsigned int generation;
+    vector<pair<int, int> > heap;
+
+    // result of the last search: the node the path leaves for dest and from which end of dest's corridor it arrives,
+    // -1 if the path stays in the corridor of source
+    int lastNode;
+    int lastEnd;
+    vector<int> nodePath;
+
+    // number of nodes expanded by the last search
+    int expanded;
+
+    void allocate() {
+        int nodes = map->getNodes();
+        g.assign(nodes, 0);
+        parentNode.assign(nodes, -1);
+        parentEdge.assign(nodes, -1);
+        seen.assign(nodes, 0);
+        closed.assign(nodes, 0);
+    }
+
+    // ways from a cell to the nodes around it: the node itself, or both ends of its corridor
+    int reachNodes(int cell, int nodes[2], int costs[2], int sides[2]) const {
+        const CorridorMap &m = *map;
+        if(m.nodeOf[cell] != -1) {
+            nodes[0] = m.nodeOf[cell];
+            costs[0] = 0;
+            sides[0] = FROM_SOURCE;
+            return 1;
+        }
+        int c = m.corridorOf[cell], p = m.positionOf[cell];
+        nodes[0] = m.corridorEnds[2 * c];
+        costs[0] = p + 1;
+        sides[0] = FROM_FRONT;
+        nodes[1] = m.corridorEnds[2 * c + 1];
+        costs[1] = m.corridorLength(c) - p;
+        sides[1] = FROM_BACK;
+        return 2;
+    }
+
+    // length of the shortest path from source to dest, or -1
+    int search(int source, int dest) {
+        const CorridorMap &m = *map;
+        lastNode = -1;
+        lastEnd = FROM_SOURCE;
+        expanded = 0;
+
+        int best = INT_MAX;
+        if(m.nodeOf[source] == -1 && m.nodeOf[dest] == -1 && m.corridorOf[source] == m.corridorOf[dest])
+            best = abs(m.positionOf[source] - m.positionOf[dest]);
+
+        int goalNodes[2], goalCosts[2], goalSides[2];
+        int goals = reachNodes(dest, goalNodes, goalCosts, goalSides);
+
+        if(++generation == 0) {
+            seen.assign(seen.size(), 0);
+            closed.assign(closed.size(), 0);
+            generation = 1;
+        }
+        heap.clear();
+        int startNodes[2], startCosts[2], startSides[2];
+        int starts = reachNodes(source, startNodes, startCosts, startSides);
+        for(int i = 0; i < starts; i++) {
+            int n = startNodes[i];
+            if(seen[n] == generation && g[n] <= startCosts[i])
+                continue;
+            seen[n] = generation;
+            g[n] = startCosts[i];
+            parentNode[n] = -1;
+            parentEdge[n] = startSides[i];
+            heap.push_back(make_pair(g[n] + m.heuristic(m.nodeCell[n], dest), n));
+        }
+        make_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+
+        while(!heap.empty() && heap.front().first < best) {
+            pop_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+            int f = heap.back().first, n = heap.back().second;
+            heap.pop_back();
+            if(closed[n] == generation || g[n] + m.heuristic(m.nodeCell[n], dest) != f)
+                continue;
+            closed[n] = generation;
+            expanded++;
+
+            for(int i = 0; i < goals; i++) {
+                if(goalNodes[i] == n && g[n] + goalCosts[i] < best) {
+                    best = g[n] + goalCosts[i];
+                    lastNode = n;
+                    lastEnd = goalSides[i];
+                }
+            }
+
+            for(int e = m.edgeOffsets[n]; e < m.edgeOffsets[n + 1]; e++) {
+                int k = m.edgeTarget[e];
+
+                // a dead end only leads back, it is only worth visiting if dest is there
+                if(m.edgeOffsets[k + 1] - m.edgeOffsets[k] == 1 && k != goalNodes[0] && k != goalNodes[goals - 1])
+                    continue;
+                int next = g[n] + m.corridorLength(m.edgeCorridor[e]) + 1;
+                if(seen[k] != generation || next < g[k]) {
+                    seen[k] = generation;
+                    g[k] = next;
+                    parentNode[k] = n;
+                    parentEdge[k] = e;
+                    heap.push_back(make_pair(next + m.heuristic(m.nodeCell[k], dest), k));
+                    push_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+                }
+            }
+        }
+
+        if(best == INT_MAX)
+            return -1;
+        nodePath.clear();
+        for(int n = lastNode; n != -1; n = parentNode[n])
+            nodePath.push_back(n);
+        reverse(nodePath.begin(), nodePath.end());
+        return best;
+    }
+
+    // write the result of search as cells, stops after the first piece that isn't empty if firstPart is set
+    void writePath(int source, int dest, vector<int> &path, bool firstPart) {
+        const CorridorMap &m = *map;
+        if(lastNode == -1) {
+            int c = m.corridorOf[source], from = m.positionOf[source], to = m.positionOf[dest];
+            m.appendCorridor(c, from < to ? from + 1 : from - 1, to, path);
+            return;
+        }
+
+        // from source to the first node
+        int first = nodePath[0];
+        if(parentEdge[first] != FROM_SOURCE) {
+            int c = m.corridorOf[source], p = m.positionOf[source];
+            if(parentEdge[first] == FROM_FRONT && p > 0)
+                m.appendCorridor(c, p - 1, 0, path);
+            if(parentEdge[first] == FROM_BACK && p < m.corridorLength(c) - 1)
+                m.appendCorridor(c, p + 1, m.corridorLength(c) - 1, path);
+            path.push_back(m.nodeCell[first]);
+        }
+
+        // from node to node
+        for(size_t i = 1; i < nodePath.size() && !(firstPart && !path.empty()); i++) {
+            int c = m.edgeCorridor[parentEdge[nodePath[i]]];
+            int length = m.corridorLength(c);
+            if(length > 0) {
+                if(m.corridorEnds[2 * c] == nodePath[i - 1]) m.appendCorridor(c, 0, length - 1, path);
+                else m.appendCorridor(c, length - 1, 0, path);
+            }
+            path.push_back(m.nodeCell[nodePath[i]]);
+        }
+
+        // from the last node to dest
+        if(lastEnd != FROM_SOURCE && !(firstPart && !path.empty())) {
+            int c = m.corridorOf[dest];
+            m.appendCorridor(c, lastEnd == FROM_FRONT ? 0 : m.corridorLength(c) - 1, m.positionOf[dest], path);
+        }
+    }
+
+public:
+
+    // build the map and search on it
+    explicit CorridorGraph(const NavGraph &graph) : ownMap(new CorridorMap(graph)), map(ownMap.get()), generation(0),
+            lastNode(-1), lastEnd(FROM_SOURCE), expanded(0) {
+        allocate();
+    }
+
+    // search on a map shared with other engines, it has to outlive the engine
+    explicit CorridorGraph(const CorridorMap &map) : map(&map), generation(0), lastNode(-1), lastEnd(FROM_SOURCE), expanded(0) {
+        allocate();
+    }
+
+    bool getPath(int source, int dest, vector<int> &path) override {
+        path.clear();
+        if(source == dest || search(source, dest) == -1)
+            return false;
+        writePath(source, dest, path, false);
+        return true;
+    }
+
+    // the path up to the first junction or dead end, after that a ghost has to choose again
+    bool getPathStart(int source, int dest, vector<int> &path) override {
+        path.clear();
+        if(source == dest || search(source, dest) == -1)
+            return false;
+        writePath(source, dest, path, true);
+        return true;
+    }
+
+    const CorridorMap& getMap() const {
+        return *map;
+    }
+
+    // true for cells with exactly two passages, where a ghost can only go on or back
+    bool isCorridor(int cell) const {
+        return map->isCorridor(cell);
+    }
+
+    int getNodes() const {
+        return map->getNodes();
+    }
+
+    int getEdges() const {
+        return map->getEdges();
+    }
+
+    int getExpanded() const {
+        return expanded;
+    }
+
+    const char* getName() const override {
+        return "corridor graph";
+    }
+};
+
+#endif // OPENGLPRJ_CORRIDORGRAPH_H
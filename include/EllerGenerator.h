@@ -0,0 +1,214 @@
+#ifndef OPENGLPRJ_ELLERGENERATOR_H
+#define OPENGLPRJ_ELLERGENERATOR_H
+#include <vector>
+#include "Cell.h"
+#include "Random.h"
+#include "Generator.h"
+using namespace std;
+
+// Eller's algorithm: carves a maze one row at a time and only remembers which cells of the current row are connected,
+// so the working memory is O(cols) however many rows are made, and rows can be made as they are needed
+// the cells of a row are kept in sets with a small union-find on the columns; every set reaches the next row
+// through at least one passage down, and the last row joins all sets, so the finished maze is connected
+class EllerGenerator {
+private:
+    int cols;
+    Random random;
+
+    // percent of walls between two cells that are already connected that are opened anyway,
+    // and of dead ends that get a passage down, 0 makes a perfect maze
+    int loopChance;
+
+    // union-find over the columns of the current row, a root column stands for its set
+    vector<int> parent;
+
+    // cells of the current row that have a passage up to the previous row, and the set they come from
+    vector<int> fromAbove;
+
+    // per set of the row being finished: cells not yet given their chance to go down, and if one went down already
+    vector<int> remaining;
+    vector<bool> wentDown;
+
+    // column of the next row that a set of the current row continues in
+    vector<int> firstBelow;
+
+    int find(int col) {
+        while(parent[col] != col) {
+            parent[col] = parent[parent[col]];
+            col = parent[col];
+        }
+        return col;
+    }
+
+    void join(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if(a != b)
+            parent[b] = a;
+    }
+
+public:
+    EllerGenerator(int cols, const Random &random, int loopChance = 0)
+        : cols(cols), random(random), loopChance(loopChance),
+          parent(cols), fromAbove(cols, -1), remaining(cols), wentDown(cols), firstBelow(cols) {}
+
+    // carve the passages of the next row; the cells must start with all walls closed
+    // the last row of a finite maze joins every set left, an endless maze never has one
+    void nextRow(Cell *row, bool last) {
+        // cells reached from above continue the set they came from, the others start a set of their own
+        for(int j=0; j<cols; j++) {
+            parent[j] = j;
+            if(fromAbove[j] != -1) {
+                row[j].setWallUp(false);
+                firstBelow[fromAbove[j]] = -1;
+            }
+        }
+        for(int j=0; j<cols; j++) {
+            if(fromAbove[j] != -1) {
+                int &first = firstBelow[fromAbove[j]];
+                if(first == -1)
+                    first = j;
+                else
+                    parent[j] = first;
+            }
+        }
+
+        // join neighbors in different sets at random, all of them on the last row
+        for(int j=0; j+1<cols; j++) {
+            bool open;
+            if(find(j) != find(j + 1))
+                open = last || random.below(2) == 0;
+            else
+                open = !last && (int)random.below(100) < loopChance;
+            if(open) {
+                row[j].setWallRight(false);
+                row[j + 1].setWallLeft(false);
+                join(j, j + 1);
+            }
+        }
+
+        if(last) {
+            fill(fromAbove.begin(), fromAbove.end(), -1);
+            return;
+        }
+
+        // passages down: every cell goes down with even odds, and the last cell of a set that has none yet always does
+        // with loops a dead end gets loopChance to go down as well, which doesn't close a loop yet but leaves fewer dead ends
+        for(int j=0; j<cols; j++) {
+            int set = find(j);
+            parent[j] = set;
+            remaining[j] = 0;
+            wentDown[j] = false;
+        }
+        for(int j=0; j<cols; j++)
+            remaining[parent[j]]++;
+        for(int j=0; j<cols; j++) {
+            int set = parent[j];
+            remaining[set]--;
+            bool deadEnd = row[j].wallUp() + row[j].wallLeft() + row[j].wallRight() >= 2;
+            if(random.below(2) == 0 || (remaining[set] == 0 && !wentDown[set])
+               || (deadEnd && (int)random.below(100) < loopChance)) {
+                row[j].setWallDown(false);
+                wentDown[set] = true;
+                fromAbove[j] = set;
+            } else {
+                fromAbove[j] = -1;
+            }
+        }
+    }
+
+    // memory of the row state, the same for any number of rows
+    size_t getMemoryBytes() const {
+        return (parent.capacity() + fromAbove.capacity() + remaining.capacity() + firstBelow.capacity()) * sizeof(int)
+            + wentDown.capacity() / 8;
+    }
+};
+
+// Eller's over a whole grid, for finite mazes
+class EllerMazeGenerator : public Generator {
+private:
+    int loopChance;
+    size_t peakBytes;
+
+public:
+    explicit EllerMazeGenerator(int loopChance = 0) : loopChance(loopChance), peakBytes(0) {}
+
+    // the rows are carved from top to bottom, each only needs the sets of the row before it
+    void carve(Grid &grid, Random &random) override {
+        int rows = grid.getRows();
+        EllerGenerator eller(grid.getCols(), random, loopChance);
+        for(int i=0; i<rows; i++)
+            eller.nextRow(grid[i], i == rows - 1);
+        peakBytes = eller.getMemoryBytes();
+    }
+
+    size_t getPeakMemoryBytes() const override {
+        return peakBytes;
+    }
+
+    const char* getName() const override {
+        return "eller";
+    }
+};
+
+// maze that goes on downwards without end: only a window of rows around the player is in memory,
+// rows ahead are generated when the player comes close to them and rows far behind are dropped
+// the rows are kept in a ring, row r is in slot r % windowRows
+class EndlessMaze {
+private:
+    int cols;
+    int windowRows;
+    EllerGenerator generator;
+
+    vector<Cell> cells;
+
+    // rows generated so far, rows below generatedRows - windowRows have been dropped
+    long long generatedRows;
+
+public:
+    EndlessMaze(int cols, int windowRows, uint64_t seed, int loopChance = 0)
+        : cols(cols), windowRows(windowRows), generator(cols, Random(seed), loopChance),
+          cells((size_t)cols * windowRows), generatedRows(0) {}
+
+    int getCols() const { return cols; }
+    int getWindowRows() const { return windowRows; }
+    long long getGeneratedRows() const { return generatedRows; }
+
+    // first row still in memory
+    long long getFirstRow() const {
+        return generatedRows > windowRows ? generatedRows - windowRows : 0;
+    }
+
+    bool isLoaded(long long row) const {
+        return row >= getFirstRow() && row < generatedRows;
+    }
+
+    // make sure the rows up to lookAhead rows past the player exist, dropping the oldest rows to make room
+    // lookAhead has to be smaller than the window, so the player's own row stays loaded
+    void advanceTo(long long playerRow, int lookAhead) {
+        while(generatedRows <= playerRow + lookAhead) {
+            Cell *row = &cells[(size_t)(generatedRows % windowRows) * cols];
+            for(int j=0; j<cols; j++) {
+                row[j].closeAll();
+                row[j].setCoin(true);
+            }
+            generator.nextRow(row, false);
+            generatedRows++;
+        }
+    }
+
+    // cells of a loaded row
+    Cell* operator[](long long row) {
+        return &cells[(size_t)(row % windowRows) * cols];
+    }
+
+    const Cell* operator[](long long row) const {
+        return &cells[(size_t)(row % windowRows) * cols];
+    }
+
+    size_t getMemoryBytes() const {
+        return cells.capacity() * sizeof(Cell) + generator.getMemoryBytes();
+    }
+};
+
+#endif // OPENGLPRJ_ELLERGENERATOR_H
@@ -0,0 +1,179 @@
+#ifndef OPENGLPRJ_FIELDSERVICE_H
+#define OPENGLPRJ_FIELDSERVICE_H
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "NavGraph.h"
+#include "FlowField.h"
+#include "FleeField.h"
+using namespace std;
+
+// the flow field to pacman's cell and the flee field built from it, updated on a worker thread
+// on large mazes a move of pacman can cost a full search and a flee field a few hundred milliseconds, too long for a frame
+// the worker owns the fields and repairs them from one target to the next, a finished field is copied to the spare
+// of two published copies and poll() swaps it in, so the render thread reads the previous field while the worker is busy
+// a field finished for a target that isn't wanted anymore is dropped, the worker goes on from it to the new target
+// all calls are made from one thread (the render loop), only the worker runs in parallel to it
+class FieldService {
+private:
+
+    // fields the ghosts read, the flee field is only valid if it was built for the target of the flow field
+    struct Fields {
+        FlowField flow;
+        FleeField flee;
+    };
+
+    // the spare copy is free, being written by the worker, or holds fields poll() hasn't swapped in yet
+    enum Spare { SPARE_FREE, SPARE_WRITING, SPARE_READY };
+
+    // fields of the worker, only it touches them
+    FlowField flowField;
+    FleeField fleeField;
+
+    // published[front] is read by the render thread, the worker only writes the other one
+    Fields published[2];
+    int front;
+    Spare spare;
+
+    mutex lock;
+    condition_variable wake;
+    condition_variable finished;
+    int wantedTarget;
+    bool wantFlee;
+    // target of the newest fields the worker copied out and whether they have a flee field
+    int doneTarget;
+    bool doneFlee;
+    bool stopping;
+    int publishes;
+    int drops;
+    thread worker;
+
+    bool hasWork() const {
+        return wantedTarget != -1 && (wantedTarget != doneTarget || (wantFlee && !doneFlee));
+    }
+
+    void work() {
+        unique_lock<mutex> guard(lock);
+        while(true) {
+            wake.wait(guard, [this] { return stopping || hasWork(); });
+            if(stopping)
+                return;
+            int target = wantedTarget;
+            bool flee = wantFlee;
+
+            guard.unlock();
+            flowField.update(target);
+            if(flee)
+                fleeField.update(flowField);
+            guard.lock();
+
+            // pacman left the cell while the field was searched, the next round repairs it to the new cell
+            if(target != wantedTarget) {
+                drops++;
+                continue;
+            }
+
+            // poll() doesn't swap while the spare is written, so the render thread never sees half a copy
+            spare = SPARE_WRITING;
+            Fields &fields = published[1 - front];
+            guard.unlock();
+            fields.flow.copyField(flowField);
+            if(flee)
+                fields.flee.copyField(fleeField);
+            guard.lock();
+            spare = SPARE_READY;
+            doneTarget = target;
+            doneFlee = flee;
+            publishes++;
+            finished.notify_all();
+        }
+    }
+
+public:
+
+    explicit FieldService(const NavGraph &graph) : flowField(graph), fleeField(graph), front(0), spare(SPARE_FREE),
+            wantedTarget(-1), wantFlee(false), doneTarget(-1), doneFlee(false), stopping(false), publishes(0), drops(0) {
+        // both copies can be read before the first field is done, every cell is unreachable in them
+        for(Fields &fields : published) {
+            fields.flow.copyField(flowField);
+            fields.flee.copyField(fleeField);
+        }
+        worker = thread(&FieldService::work, this);
+    }
+
+    FieldService(const FieldService&) = delete;
+    FieldService& operator=(const FieldService&) = delete;
+
+    // a field being searched is finished first
+    ~FieldService() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+
+    // ask for the fields to target, with a flee field if flee is set, a newer request replaces one the worker hasn't finished
+    void request(int target, bool flee) {
+        {
+            lock_guard<mutex> guard(lock);
+            if(target == wantedTarget && flee == wantFlee)
+                return;
+            wantedTarget = target;
+            wantFlee = flee;
+        }
+        wake.notify_one();
+    }
+
+    // swap in the newest finished fields, returns true if there were any
+    bool poll() {
+        lock_guard<mutex> guard(lock);
+        if(spare != SPARE_READY)
+            return false;
+        front = 1 - front;
+        spare = SPARE_FREE;
+        return true;
+    }
+
+    // wait until the fields of the last request are done and swap them in, for tools that need them at once
+    void finish() {
+        unique_lock<mutex> guard(lock);
+        finished.wait(guard, [this] { return !hasWork() && spare != SPARE_WRITING; });
+        if(spare == SPARE_READY) {
+            front = 1 - front;
+            spare = SPARE_FREE;
+        }
+    }
+
+    // target of the last request, -1 before the first one
+    int getTarget() const {
+        return wantedTarget;
+    }
+
+    // newest flow field swapped in, its target can be behind the requested one
+    const FlowField& getFlowField() const {
+        return published[front].flow;
+    }
+
+    // flee field of the newest fields swapped in, nullptr if none was built for their target
+    const FleeField* getFleeField() const {
+        const Fields &fields = published[front];
+        if(fields.flow.getTarget() == -1 || fields.flee.getTarget() != fields.flow.getTarget())
+            return nullptr;
+        return &fields.flee;
+    }
+
+    // fields copied out, and fields dropped because the target changed while they were searched
+    int getPublishes() {
+        lock_guard<mutex> guard(lock);
+        return publishes;
+    }
+
+    int getDrops() {
+        lock_guard<mutex> guard(lock);
+        return drops;
+    }
+};
+
+#endif // OPENGLPRJ_FIELDSERVICE_H
@@ -0,0 +1,131 @@
+#ifndef OPENGLPRJ_FLEEFIELD_H
+#define OPENGLPRJ_FLEEFIELD_H
+#include <vector>
+#include <algorithm>
+#include "NavGraph.h"
+#include "FlowField.h"
+using namespace std;
+
+// where scared ghosts run to, shared by all of them
+// every cell starts with its maze distance from pacman scaled by -1.2, so going further away is always downhill,
+// then the field is rescanned so that no cell is more than one step above its lowest neighbor
+// a dead end close to pacman becomes a bump the ghosts run around instead of a place where they get trapped,
+// and the ghosts head for the far side of the maze along paths that lead somewhere
+// a ghost steps to its lowest neighbor, which is a few reads per step
+class FleeField {
+
+private:
+
+    // integer version of the factor -1.2: one step costs stepCost and the distance is scaled by -fleeFactor
+    static const int stepCost = 5;
+    static const int fleeFactor = 6;
+
+    const NavGraph* graph;
+    int V;
+    vector<int> value;
+
+    // flow field the field was built from, the sum of its searches and repairs changes whenever its distances do
+    int builtTarget;
+    int builtVersion;
+
+    // memory reused by every rebuild
+    vector<int> order;
+    vector<int> bucketStart;
+    vector<int> queue;
+
+    int rebuilds;
+
+    void rebuild(const FlowField &flowField) {
+        // cells sorted by falling distance, which is rising value, cells that can't reach pacman are the safest
+        int maxDistance = 0;
+        for(int v=0; v<V; v++)
+            maxDistance = max(maxDistance, flowField.getDistance(v));
+        bucketStart.assign(maxDistance + 3, 0);
+        for(int v=0; v<V; v++) {
+            int d = flowField.getDistance(v);
+            bucketStart[(d == FlowField::unreachable ? 0 : maxDistance + 1 - d) + 1]++;
+        }
+        for(size_t b=1; b<bucketStart.size(); b++)
+            bucketStart[b] += bucketStart[b-1];
+        for(int v=0; v<V; v++) {
+            int d = flowField.getDistance(v);
+            int b = d == FlowField::unreachable ? 0 : maxDistance + 1 - d;
+            order[bucketStart[b]++] = v;
+            value[v] = -fleeFactor * (d == FlowField::unreachable ? maxDistance + 1 : d);
+        }
+
+        // rescan: every step costs the same, so merging the sorted cells with a FIFO queue visits cells in order of value
+        size_t seed = 0;
+        int head = 0, tail = 0;
+        while(seed < order.size() || head < tail) {
+            int temp;
+            if(head < tail && (seed == order.size() || value[queue[head]] <= value[order[seed]])) {
+                temp = queue[head++];
+            }else{
+                temp = order[seed++];
+            }
+            int next = value[temp] + stepCost;
+            for(int k: graph->neighborsOf(temp)) {
+                if(next < value[k]) {
+                    value[k] = next;
+                    queue[tail++] = k;
+                }
+            }
+        }
+        rebuilds++;
+    }
+
+public:
+
+    FleeField() : graph(nullptr), V(0), builtTarget(-1), builtVersion(-1), rebuilds(0) {}
+
+    explicit FleeField(const NavGraph &graph) : graph(&graph), V(graph.getV()), value(V, 0), builtTarget(-1), builtVersion(-1),
+            order(V), queue(V), rebuilds(0) {}
+
+    // rebuild from the distances of the flow field if they changed since the last time
+    void update(const FlowField &flowField) {
+        int version = flowField.getSearches() + flowField.getRepairs();
+        if(flowField.getTarget() == builtTarget && version == builtVersion)
+            return;
+        builtTarget = flowField.getTarget();
+        builtVersion = version;
+        rebuild(flowField);
+    }
+
+    // copy the values of another field, not the memory of its rebuilds, so the copy can be read but not updated
+    void copyField(const FleeField &from) {
+        graph = from.graph;
+        V = from.V;
+        value = from.value;
+        builtTarget = from.builtTarget;
+        builtVersion = from.builtVersion;
+        rebuilds = from.rebuilds;
+    }
+
+    // lowest neighbor of source if it is lower than source, otherwise -1 and the ghost stays where it is
+    int getNextCell(int source) const {
+        int best = -1, bestValue = value[source];
+        for(int k: graph->neighborsOf(source)) {
+            if(value[k] < bestValue) {
+                best = k;
+                bestValue = value[k];
+            }
+        }
+        return best;
+    }
+
+    int getValue(int cell) const {
+        return value[cell];
+    }
+
+    // target of the flow field the values were built from, -1 before the first rebuild
+    int getTarget() const {
+        return builtTarget;
+    }
+
+    int getRebuilds() const {
+        return rebuilds;
+    }
+};
+
+#endif // OPENGLPRJ_FLEEFIELD_H
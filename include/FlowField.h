@@ -0,0 +1,409 @@
+#ifndef OPENGLPRJ_FLOWFIELD_H
+#define OPENGLPRJ_FLOWFIELD_H
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include "NavGraph.h"
+using namespace std;
+
+// distance from every cell to one target cell (pacman), shared by all chasing ghosts
+// a ghost just steps to the neighbor that is closer to the target
+//
+// the field is repaired instead of recomputed when it can be:
+// - when the target moves to a neighboring cell every distance changes by exactly one (the grid is bipartite),
+//   so the distances are shifted with a shared offset and only the smaller set of cells that went the other way is rewritten
+// - when a wall opens or closes only the cells whose distance changes are visited
+// anything else runs one BFS from the target
+class FlowField {
+
+private:
+
+    // directions of the passage bits, in the same order the graph lists neighbors
+    enum Direction { UP = 0, DOWN = 1, LEFT = 2, RIGHT = 3 };
+
+    // stored distance of cells that can't reach the target
+    static const int infinite = INT_MAX;
+
+    int V;
+    int cols;
+    int target;
+
+    // distance of cell v is stored[v] + offset
+    vector<int> stored;
+    int offset;
+
+    // one bit per open side of each cell, copied from the graph so walls can be changed
+    vector<unsigned char> passages;
+
+    // memory reused by the searches
+    vector<int> queue;
+    vector<pair<int, int> > work;
+    vector<unsigned int> mark;
+    vector<int> otherQueue;
+    vector<unsigned int> otherMark;
+    unsigned int generation;
+
+    // a repair that ran over budget is only tried again after this many moves were searched in full,
+    // on a maze where repairs don't pay off the moves cost little more than the searches
+    static const int repairRetry = 16;
+    int movesUntilRepair;
+
+    // number of full searches and of repairs, and cells written by the last update
+    int searches;
+    int repairs;
+    int touched;
+
+    int step(int dir) const {
+        switch(dir) {
+            case UP: return -cols;
+            case DOWN: return cols;
+            case LEFT: return -1;
+            default: return 1;
+        }
+    }
+
+    bool isOpen(int v, int dir) const {
+        return (passages[v] >> dir) & 1;
+    }
+
+    int value(int v) const {
+        return stored[v] == infinite ? infinite : stored[v] + offset;
+    }
+
+    void setValue(int v, int dist) {
+        stored[v] = dist == infinite ? infinite : dist - offset;
+    }
+
+    void newMarks() {
+        if(++generation == 0) {
+            mark.assign(V, 0);
+            otherMark.assign(V, 0);
+            generation = 1;
+        }
+    }
+
+    // BFS from the target
+    void recompute() {
+        stored.assign(V, (int)infinite);
+        offset = 0;
+        int head = 0, tail = 0;
+        queue[tail++] = target;
+        stored[target] = 0;
+
+        while(head < tail) {
+            int temp = queue[head++];
+            for(int dir=0; dir<4; dir++) {
+                int k = temp + step(dir);
+                if(isOpen(temp, dir) && stored[k] == infinite) {
+                    stored[k] = stored[temp] + 1;
+                    queue[tail++] = k;
+                }
+            }
+        }
+        searches++;
+        touched = tail;
+    }
+
+    // the target moved from its cell to the neighboring cell next
+    // cells with a shortest path through next (closer) get one step closer and all others (further) one step further,
+    // both sets are grown one cell at a time and only the one that is complete first is rewritten,
+    // the rest of the cells follow through the offset
+    // in mazes with many loops both sets can be large, growing them costs more per cell than a search does,
+    // so when a sixteenth of the cells have been grown without either set being complete it gives up and returns false
+    bool moveToNeighbor(int next) {
+        int budget = V / 16;
+        newMarks();
+        int closerHead = 0, closerTail = 0;
+        int furtherHead = 0, furtherTail = 0;
+        queue[closerTail++] = next;
+        mark[next] = generation;
+        otherQueue[furtherTail++] = target;
+        otherMark[target] = generation;
+
+        while(closerHead < closerTail && furtherHead < furtherTail) {
+            if(closerHead + furtherHead > budget)
+                return false;
+            // a cell is closer if one of the cells before it on a shortest path is
+            int temp = queue[closerHead++];
+            int dist = value(temp);
+            for(int dir=0; dir<4; dir++) {
+                int k = temp + step(dir);
+                if(isOpen(temp, dir) && mark[k] != generation && value(k) == dist + 1) {
+                    mark[k] = generation;
+                    queue[closerTail++] = k;
+                }
+            }
+
+            // a cell is further if all cells before it on shortest paths are,
+            // found level by level so they are all known before the cell is checked
+            temp = otherQueue[furtherHead++];
+            dist = value(temp);
+            for(int dir=0; dir<4; dir++) {
+                int k = temp + step(dir);
+                if(isOpen(temp, dir) && otherMark[k] != generation && k != next && value(k) == dist + 1 && allParentsFurther(k)) {
+                    otherMark[k] = generation;
+                    otherQueue[furtherTail++] = k;
+                }
+            }
+        }
+
+        if(closerHead == closerTail) {
+            offset++;
+            for(int i=0; i<closerTail; i++)
+                stored[queue[i]] -= 2;
+            touched = closerTail;
+        }else{
+            offset--;
+            for(int i=0; i<furtherTail; i++)
+                stored[otherQueue[i]] += 2;
+            touched = furtherTail;
+        }
+        target = next;
+        repairs++;
+        return true;
+    }
+
+    bool allParentsFurther(int v) const {
+        int dist = value(v);
+        for(int dir=0; dir<4; dir++) {
+            int k = v + step(dir);
+            if(isOpen(v, dir) && otherMark[k] != generation && value(k) == dist - 1)
+                return false;
+        }
+        return true;
+    }
+
+    // lower distances starting from cell v, which can now be reached in dist steps
+    void propagateDecrease(int v, int dist) {
+        setValue(v, dist);
+        int head = 0, tail = 0;
+        queue[tail++] = v;
+
+        while(head < tail) {
+            int temp = queue[head++];
+            int next = value(temp) + 1;
+            for(int dir=0; dir<4; dir++) {
+                int k = temp + step(dir);
+                if(isOpen(temp, dir) && next < value(k)) {
+                    setValue(k, next);
+                    queue[tail++] = k;
+                }
+            }
+        }
+        touched = tail;
+    }
+
+    // does v still have a neighbor one step closer to the target that isn't marked as affected
+    bool hasSupport(int v) const {
+        int dist = value(v);
+        for(int dir=0; dir<4; dir++) {
+            int k = v + step(dir);
+            if(isOpen(v, dir) && mark[k] != generation && value(k) == dist - 1)
+                return true;
+        }
+        return false;
+    }
+
+    // the passage into cell child, that was on its shortest paths, was closed
+    // find the cells that lost all their shortest paths, then give them distances from the cells around them
+    void propagateIncrease(int child) {
+        newMarks();
+        if(hasSupport(child))
+            return;
+
+        // affected cells, found level by level so all affected parents are known before a cell is checked
+        mark[child] = generation;
+        int head = 0, tail = 0;
+        queue[tail++] = child;
+        while(head < tail) {
+            int temp = queue[head++];
+            int dist = value(temp);
+            for(int dir=0; dir<4; dir++) {
+                int k = temp + step(dir);
+                if(isOpen(temp, dir) && mark[k] != generation && value(k) == dist + 1 && !hasSupport(k)) {
+                    mark[k] = generation;
+                    queue[tail++] = k;
+                }
+            }
+        }
+        int affected = tail;
+
+        // new distance of each affected cell through its unaffected neighbors
+        work.clear();
+        for(int i=0; i<affected; i++) {
+            int v = queue[i];
+            int best = infinite;
+            for(int dir=0; dir<4; dir++) {
+                int k = v + step(dir);
+                if(isOpen(v, dir) && mark[k] != generation && value(k) != infinite)
+                    best = min(best, value(k) + 1);
+            }
+            stored[v] = infinite;
+            if(best != infinite)
+                work.push_back(make_pair(best, v));
+        }
+        sort(work.begin(), work.end());
+        for(size_t i=0; i<work.size(); i++)
+            if(work[i].first < value(work[i].second))
+                setValue(work[i].second, work[i].first);
+
+        // unit edges, so merging the sorted seeds with a FIFO queue visits cells in order of distance
+        size_t seed = 0;
+        head = tail = 0;
+        while(seed < work.size() || head < tail) {
+            int temp;
+            if(head < tail && (seed == work.size() || value(queue[head]) <= work[seed].first)) {
+                temp = queue[head++];
+            }else{
+                temp = work[seed].second;
+                if(value(temp) != work[seed++].first)
+                    continue;
+            }
+            int next = value(temp) + 1;
+            for(int dir=0; dir<4; dir++) {
+                int k = temp + step(dir);
+                if(isOpen(temp, dir) && next < value(k)) {
+                    setValue(k, next);
+                    queue[tail++] = k;
+                }
+            }
+        }
+        touched = affected;
+    }
+
+public:
+
+    static const int unreachable = -1;
+
+    FlowField() : V(0), cols(0), target(-1), offset(0), generation(0), movesUntilRepair(0), searches(0), repairs(0), touched(0) {}
+
+    explicit FlowField(const NavGraph &graph) : V(graph.getV()), cols(graph.getCols()), target(-1), stored(V, (int)infinite), offset(0),
+            passages(V, 0), queue(V), mark(V, 0), otherQueue(V), otherMark(V, 0), generation(0), movesUntilRepair(0),
+            searches(0), repairs(0), touched(0) {
+        for(int v=0; v<V; v++) {
+            for(int k: graph.neighborsOf(v)) {
+                if(k == v - cols) passages[v] |= 1 << UP;
+                else if(k == v + cols) passages[v] |= 1 << DOWN;
+                else if(k == v - 1) passages[v] |= 1 << LEFT;
+                else passages[v] |= 1 << RIGHT;
+            }
+        }
+    }
+
+    // set the target cell, returns true if the field changed
+    // a move to a neighboring cell is repaired, any other change or a repair over budget runs a full search
+    bool update(int target) {
+        if(target == this->target)
+            return false;
+
+        int previous = this->target;
+        if(previous != -1 && stored[target] != infinite) {
+            for(int dir=0; dir<4; dir++) {
+                if(isOpen(previous, dir) && previous + step(dir) == target) {
+                    if(movesUntilRepair > 0) {
+                        movesUntilRepair--;
+                        break;
+                    }
+                    if(moveToNeighbor(target))
+                        return true;
+                    movesUntilRepair = repairRetry - 1;
+                    break;
+                }
+            }
+        }
+        this->target = target;
+        recompute();
+        return true;
+    }
+
+    // copy the distances of another field, not the memory of its searches, so the copy can be read but not updated
+    // the vectors keep their capacity, copying into the same field again doesn't allocate
+    void copyField(const FlowField &from) {
+        V = from.V;
+        cols = from.cols;
+        target = from.target;
+        stored = from.stored;
+        offset = from.offset;
+        passages = from.passages;
+        searches = from.searches;
+        repairs = from.repairs;
+        touched = from.touched;
+    }
+
+    // run a full search from the current target
+    void rebuild() {
+        if(target != -1)
+            recompute();
+    }
+
+    // open or close the side dir (0 up, 1 down, 2 left, 3 right) of cell v and the matching side of its neighbor,
+    // which has to be inside the maze
+    // the field is repaired, the maze and the graph are not changed
+    void setPassage(int v, int dir, bool open) {
+        int k = v + step(dir);
+        int opposite = dir ^ 1;
+        if(isOpen(v, dir) == open)
+            return;
+
+        if(open) {
+            passages[v] |= 1 << dir;
+            passages[k] |= 1 << opposite;
+        }else{
+            passages[v] &= ~(1 << dir);
+            passages[k] &= ~(1 << opposite);
+        }
+        touched = 0;
+        if(target == -1)
+            return;
+
+        int dv = value(v), dk = value(k);
+        if(open) {
+            if(dv != infinite && dv + 1 < dk) propagateDecrease(k, dv + 1);
+            else if(dk != infinite && dk + 1 < dv) propagateDecrease(v, dk + 1);
+        }else{
+            if(dv != infinite && dk == dv + 1) propagateIncrease(k);
+            else if(dk != infinite && dv == dk + 1) propagateIncrease(v);
+        }
+        repairs++;
+    }
+
+    bool isPassage(int v, int dir) const {
+        return isOpen(v, dir);
+    }
+
+    int getTarget() const {
+        return target;
+    }
+
+    int getSearches() const {
+        return searches;
+    }
+
+    int getRepairs() const {
+        return repairs;
+    }
+
+    // cells written by the last update, rebuild or wall change
+    int getTouched() const {
+        return touched;
+    }
+
+    // number of steps from cell to the target, or unreachable
+    int getDistance(int cell) const {
+        int dist = value(cell);
+        return dist == infinite ? unreachable : dist;
+    }
+
+    // neighbor of source that is one step closer to the target, or -1 if source is the target or can't reach it
+    int getNextCell(int source) const {
+        int dist = value(source);
+        if(dist == infinite || dist == 0)
+            return -1;
+        for(int dir=0; dir<4; dir++)
+            if(isOpen(source, dir) && value(source + step(dir)) == dist - 1)
+                return source + step(dir);
+        return -1;
+    }
+};
+
+#endif // OPENGLPRJ_FLOWFIELD_H
@@ -0,0 +1,52 @@
+#ifndef OPENGLPRJ_GENERATOR_H
+#define OPENGLPRJ_GENERATOR_H
+#include <cstddef>
+#include "Grid.h"
+#include "Random.h"
+
+// algorithms that carve the passages of a maze, chosen when the maze is created
+enum MazeGenerator {
+    GENERATOR_PRIM,         // randomized Prim's with extra connections, the whole grid is worked on at once (default)
+    GENERATOR_ELLER,        // Eller's, one row at a time with memory for one row besides the grid
+    GENERATOR_TILED,        // Eller's in tiles on all cores, stitched together, for very large mazes
+    GENERATOR_KRUSKAL,      // walls in random order, opened when a union-find sees their cells apart
+    GENERATOR_WILSON,       // loop-erased random walks, every perfect maze is equally likely
+    GENERATOR_BACKTRACKER   // depth-first search with an explicit stack, long corridors and few dead ends
+};
+
+// loop chance of Eller's in the game, so its mazes have loops and fewer dead ends like Prim's
+const int ellerLoopChance = 60;
+
+// interface of the maze generators, they all carve into the same grid
+class Generator {
+public:
+    virtual ~Generator() {}
+
+    // open the passages of a grid whose cells all start with closed walls and not visited,
+    // every cell must be reachable afterwards
+    virtual void carve(Grid &grid, Random &random) = 0;
+
+    // most memory the generator used besides the grid during the last carve
+    virtual size_t getPeakMemoryBytes() const = 0;
+
+    virtual const char* getName() const = 0;
+
+    // open the wall between two neighboring cells
+    static void openWall(Grid &grid, int a, int b) {
+        int cols = grid.getCols();
+        if(b < a) {
+            int t = a;
+            a = b;
+            b = t;
+        }
+        if(b == a + 1 && b % cols != 0) {
+            grid.at(a).setWallRight(false);
+            grid.at(b).setWallLeft(false);
+        } else if(b == a + cols) {
+            grid.at(a).setWallDown(false);
+            grid.at(b).setWallUp(false);
+        }
+    }
+};
+
+#endif // OPENGLPRJ_GENERATOR_H
@@ -1,16 +1,70 @@
 #ifndef OPENGLPRJ_GHOST_H
 #define OPENGLPRJ_GHOST_H
 #include <OpenGLPrj.hpp>
-#include "Bfs.h"
+#include "Navigation.h"
 #include "cmath"
+#include <algorithm>
 
 class Ghost{
 private:
-    BFS algorithm;
+    Navigation* navigation;
+    PathEngine engine;
     float moved;
     glm::vec3 destinationCellPosition;
     glm::vec3 ghostCellPosition;
-    vector<int> path;
+    PathCache path;
+
+    // the path service request the ghost is waiting for, -1 if none, its target, and the service and maze it was asked on
+    int ticket;
+    int requestedDest;
+    PathEngine requestedEngine;
+    unsigned int requestedVersion;
+    PathService::Result result;
+
+    // ask an engine's path service for a path and take it when it is ready, never waits for the search
+    // until then the ghost keeps walking its previous path, results for an old target are thrown away
+    void followService(int source, int dest, PathEngine engine){
+        PathService &service = navigation->getPathService(engine);
+        PathServiceStats &stats = navigation->pathServiceStats;
+        unsigned int version = navigation->getVersion();
+        if(ticket != -1){
+            PathService::Status status = service.poll(ticket, result);
+            if(status == PathService::PENDING && requestedDest == dest)
+                return;
+            // a request that is still queued keeps its place, asking again would put it behind all other ghosts
+            if(status == PathService::PENDING && service.retarget(ticket, source, dest)){
+                requestedDest = dest;
+                stats.retargeted++;
+                return;
+            }
+            if(status == PathService::PENDING){
+                service.cancel(ticket);
+                stats.cancelled++;
+            }else if(status == PathService::LOST){
+                stats.lost++;
+            }else if(result.dest != dest){
+                stats.stale++;
+            }
+            ticket = -1;
+            if(status == PathService::READY && result.dest == dest){
+                // the ghost went on while the search ran, the path continues from the cell it is on now
+                size_t from = result.source == source ? 0 : find(result.path.begin(), result.path.end(), source) - result.path.begin() + 1;
+                if(from <= result.path.size()){
+                    path.swap(result.path, from, dest, version);
+                    stats.taken++;
+                    return;
+                }
+                stats.missed++;
+            }
+        }
+        if(!path.lookup(dest, version)){
+            ticket = service.request(source, dest);
+            requestedDest = dest;
+            requestedEngine = engine;
+            requestedVersion = version;
+            stats.requests++;
+        }
+    }
 
 public:
     float moveSpeed;
@@ -18,25 +72,49 @@ public:
     bool isScared;
     float rotation;
 
-    Ghost() {}
+    Ghost() : navigation(nullptr), engine(ENGINE_FLOW_FIELD), ticket(-1), requestedDest(-1), requestedEngine(ENGINE_BFS), requestedVersion(0) {}
 
-    Ghost(glm::vec3 pos){
+    // the navigation is shared by all ghosts, so creating or resetting a ghost doesn't allocate
+    // engine chooses how the ghost searches its path when it chases pacman, the point to point engines search on worker threads
+    Ghost(glm::vec3 pos, Navigation &navigation, PathEngine engine = ENGINE_FLOW_FIELD){
+        this->navigation = &navigation;
+        this->engine = engine;
+        ticket = -1;
+        requestedDest = -1;
+        requestedEngine = ENGINE_BFS;
+        requestedVersion = 0;
+        path = PathCache(navigation.pathCacheStats);
         ghostCellPosition = pos;
         destinationCellPosition = pos;
         moved = 1;
         position = pos;
-        algorithm = BFS();
         isScared=false;
         moveSpeed = 0.5f;
     }
 
+    // drop the request the ghost is waiting for, has to be called before a ghost is replaced
+    // a request on an earlier maze ended when its service was stopped, there is nothing to cancel
+    void cancelSearch(){
+        if(ticket != -1 && requestedVersion == navigation->getVersion()){
+            navigation->cancelSearch(requestedEngine, ticket);
+            navigation->pathServiceStats.cancelled++;
+        }
+        ticket = -1;
+    }
+
     void move(float deltaTime, int dest){
+        if(advance(deltaTime))
+            choosePath(dest);
+    }
+
+    // move along the path, returns true when the ghost has reached a cell and needs to know where to go next
+    bool advance(float deltaTime){
         // if path is empty, set moved to 1 to get a new path on next function call
-        if(path.size()!=0){
+        if(!path.empty()){
 
             // get path coordinates
-            destinationCellPosition.x = path[0]%cols;
-            destinationCellPosition.z = path[0]/cols;
+            destinationCellPosition.x = path.next()%cols;
+            destinationCellPosition.z = path.next()/cols;
             moved += deltaTime * moveSpeed;
 
             // move ghost
@@ -63,13 +141,60 @@ public:
             ghostCellPosition = destinationCellPosition;
             position = destinationCellPosition;
             moved = 0;
-            // get path depending on if the ghost is scared
-            if(!isScared){
-                path = algorithm.getPath(ghostCellPosition.x + ghostCellPosition.z*cols, dest);
-            }else{
-                path = vector<int>();
-                path.push_back(algorithm.getRunningPath(ghostCellPosition.x + ghostCellPosition.z*cols,dest));
-            }
+            return true;
+        }
+        return false;
+    }
+
+    // cell the ghost is standing on or has last reached
+    int getCell() const{
+        return (int)ghostCellPosition.x + (int)ghostCellPosition.z*cols;
+    }
+
+    // cell the ghost walks to next, -1 if it is waiting
+    int getNextCell() const{
+        return path.next();
+    }
+
+    PathEngine getEngine() const{
+        return engine;
+    }
+
+    // path with only the next cell, empty if there is none
+    // used when the next cells of several ghosts are found together
+    void setNextCell(int next){
+        path.setNext(next);
+    }
+
+    // find where to go from the current cell
+    void choosePath(int dest){
+        // get path depending on if the ghost is scared
+        int source = getCell();
+        // the cell just reached is the front of the previous path
+        if(path.next() == source)
+            path.advance();
+        if(isScared){
+            // all scared ghosts read the same flee field
+            setNextCell(navigation->getFleeCell(source));
+        }else if(!navigation->canReach(source, dest)){
+            // pacman is in a part of a level the ghost can't get to, it waits instead of searching the whole part it is in
+            setNextCell(-1);
+        }else if(engine == ENGINE_CORRIDOR && navigation->isCorridor(source) && path.leadsTo(dest, navigation->getVersion())){
+            // inside a corridor the path to the same target goes on to the next junction, there is nothing to search
+            // once pacman changes cells the ghost asks again, pacman may have come into the corridor behind it
+        }else if(engine != ENGINE_FLOW_FIELD){
+            // the search runs on the engine's worker threads, the frame doesn't wait for it
+            followService(source, dest, engine);
+        }else if(navigation->getFieldTarget() == dest){
+            // all ghosts read the same distances, to pacman's previous cell while the worker is on the new one
+            setNextCell(navigation->getFlowField().getNextCell(source));
+        }else if(navigation->table.isBuilt()){
+            // a single table read gives the next cell of the shortest path
+            setNextCell(navigation->table.getNextCell(source, dest));
+        }else{
+            // mazes too big for the table search on the BFS workers, which need no preprocessing
+            // the path found last time is walked until pacman changes cells
+            followService(source, dest, ENGINE_BFS);
         }
     }
 };
@@ -0,0 +1,61 @@
+#ifndef OPENGLPRJ_GRID_H
+#define OPENGLPRJ_GRID_H
+#include <vector>
+#include "Cell.h"
+using namespace std;
+
+// cells of a maze of any size in one contiguous array, row after row
+// grid[row][col] works like with a vector of rows, a cell's index is col + row*cols like the cells of NavGraph,
+// so the memory is one allocation and grows linearly with the number of cells
+class Grid {
+private:
+    int rows;
+    int cols;
+    vector<Cell> cells;
+
+public:
+    // longest side a maze can have, cell indices are ints and 16384x16384 cells still fit
+    static const int maxSide = 16384;
+
+    Grid() : rows(0), cols(0) {}
+
+    Grid(int rows, int cols) : rows(rows), cols(cols), cells((size_t)rows * cols) {}
+
+    // change the size, the cells are default initialized
+    void resize(int rows, int cols) {
+        this->rows = rows;
+        this->cols = cols;
+        cells.assign((size_t)rows * cols, Cell());
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    size_t size() const { return cells.size(); }
+
+    int index(int row, int col) const {
+        return col + row * cols;
+    }
+
+    // first cell of a row
+    Cell* operator[](int row) {
+        return &cells[(size_t)row * cols];
+    }
+
+    const Cell* operator[](int row) const {
+        return &cells[(size_t)row * cols];
+    }
+
+    Cell& at(int index) {
+        return cells[index];
+    }
+
+    const Cell& at(int index) const {
+        return cells[index];
+    }
+
+    size_t getMemoryBytes() const {
+        return cells.capacity() * sizeof(Cell);
+    }
+};
+
+#endif // OPENGLPRJ_GRID_H
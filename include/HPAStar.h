@@ -0,0 +1,414 @@
+#ifndef OPENGLPRJ_HPASTAR_H
+#define OPENGLPRJ_HPASTAR_H
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <climits>
+#include <cstdlib>
+#include "NavGraph.h"
+#include "PathFinder.h"
+using namespace std;
+
+// abstract graph of the hierarchical search
+// the grid is split into square clusters, every cell with a passage into another cluster is a node of an abstract graph,
+// nodes are connected to the nodes across the passage (cost 1) and to the nodes of their own cluster they can reach
+// without leaving it (cost of that path inside the cluster), which is all computed once in the constructor
+// it is only read by the searches, so the HPAStar engines of several threads share one
+class ClusterGraph {
+
+    friend class HPAStar;
+
+public:
+
+    static const int defaultClusterSize = 32;
+
+    // BFS restricted to one cluster, indexed by the position of the cell inside the cluster
+    // every search keeps its own, the cluster graph only fills them
+    struct LocalSearch {
+        int cluster;
+        int start;
+        int originRow;
+        int originCol;
+        vector<int> dist;
+        vector<int> parent;
+        vector<int> queue;
+    };
+
+private:
+
+    const NavGraph* graph;
+    int rows;
+    int cols;
+    int clusterSize;
+    int clusterRows;
+    int clusterCols;
+
+    // nodes grouped by cluster and sorted by cell inside a cluster,
+    // the nodes of cluster c are nodeCell[clusterOffsets[c]] .. nodeCell[clusterOffsets[c+1]-1]
+    vector<int> clusterOffsets;
+    vector<int> nodeCell;
+
+    // edges of the abstract graph in compressed sparse row form
+    // a path inside a cluster is shorter than the cluster's cell count, so costs fit 16 bits for clusters up to 256x256
+    vector<int> edgeOffsets;
+    vector<int> edgeTarget;
+    vector<unsigned short> edgeCost;
+
+    int clusterOf(int cell) const {
+        return (cell / cols / clusterSize) * clusterCols + (cell % cols) / clusterSize;
+    }
+
+    int localIndex(const LocalSearch &s, int cell) const {
+        return (cell / cols - s.originRow) * clusterSize + (cell % cols - s.originCol);
+    }
+
+    int cellAt(const LocalSearch &s, int local) const {
+        return (s.originRow + local / clusterSize) * cols + s.originCol + local % clusterSize;
+    }
+
+    int heuristic(int cell, int dest) const {
+        return abs(cell % cols - dest % cols) + abs(cell / cols - dest / cols);
+    }
+
+    // node of a cell in its cluster, or -1 if the cell isn't a node
+    int findNode(int cell) const {
+        int cluster = clusterOf(cell);
+        vector<int>::const_iterator first = nodeCell.begin() + clusterOffsets[cluster];
+        vector<int>::const_iterator last = nodeCell.begin() + clusterOffsets[cluster + 1];
+        vector<int>::const_iterator it = lower_bound(first, last, cell);
+        return it != last && *it == cell ? (int)(it - nodeCell.begin()) : -1;
+    }
+
+    // distance from the start of a local search to cell, or -1 if it can't be reached inside the cluster
+    int localDistance(const LocalSearch &s, int cell) const {
+        return clusterOf(cell) == s.cluster ? s.dist[localIndex(s, cell)] : -1;
+    }
+
+    // the neighbors are found from the offset of their cell, which keeps divisions out of the loop
+    void searchCluster(LocalSearch &s, int start) const {
+        s.cluster = clusterOf(start);
+        s.start = start;
+        s.originRow = (s.cluster / clusterCols) * clusterSize;
+        s.originCol = (s.cluster % clusterCols) * clusterSize;
+        s.dist.assign(clusterSize * clusterSize, -1);
+        int height = min(clusterSize, rows - s.originRow);
+        int width = min(clusterSize, cols - s.originCol);
+
+        int head = 0, tail = 0;
+        int first = localIndex(s, start);
+        s.dist[first] = 0;
+        s.parent[first] = -1;
+        s.queue[tail++] = first;
+        while(head < tail) {
+            int temp = s.queue[head++];
+            int r = temp / clusterSize, c = temp % clusterSize;
+            int v = (s.originRow + r) * cols + s.originCol + c;
+            for(int k: graph->neighborsOf(v)) {
+                int local;
+                if(k == v - cols) local = r > 0 ? temp - clusterSize : -1;
+                else if(k == v + cols) local = r + 1 < height ? temp + clusterSize : -1;
+                else if(k == v - 1) local = c > 0 ? temp - 1 : -1;
+                else local = c + 1 < width ? temp + 1 : -1;
+                if(local != -1 && s.dist[local] == -1) {
+                    s.dist[local] = s.dist[temp] + 1;
+                    s.parent[local] = temp;
+                    s.queue[tail++] = local;
+                }
+            }
+        }
+    }
+
+    // append the cells from the start of a local search to cell, without the start
+    void appendFromStart(const LocalSearch &s, int cell, vector<int> &path) const {
+        size_t first = path.size();
+        for(int local = localIndex(s, cell); s.parent[local] != -1; local = s.parent[local])
+            path.push_back(cellAt(s, local));
+        reverse(path.begin() + first, path.end());
+    }
+
+    // append the cells from cell to the start of a local search, without cell
+    void appendToStart(const LocalSearch &s, int cell, vector<int> &path) const {
+        for(int local = s.parent[localIndex(s, cell)]; local != -1; local = s.parent[local])
+            path.push_back(cellAt(s, local));
+    }
+
+    void resizeLocal(LocalSearch &s) const {
+        s.dist.assign(clusterSize * clusterSize, -1);
+        s.parent.assign(clusterSize * clusterSize, -1);
+        s.queue.assign(clusterSize * clusterSize, 0);
+    }
+
+    template <typename T>
+    static size_t bytesOf(const vector<T> &v) {
+        return v.capacity() * sizeof(T);
+    }
+
+public:
+
+    // build the abstract graph, this is the expensive part and is done once per maze
+    explicit ClusterGraph(const NavGraph &graph, int clusterSize = defaultClusterSize) : graph(&graph), rows(graph.getRows()),
+            cols(graph.getCols()), clusterSize(clusterSize) {
+        clusterRows = (rows + clusterSize - 1) / clusterSize;
+        clusterCols = (cols + clusterSize - 1) / clusterSize;
+        int clusters = clusterRows * clusterCols;
+        LocalSearch segment;
+        resizeLocal(segment);
+
+        // nodes, cluster by cluster so they come out sorted
+        clusterOffsets.assign(clusters + 1, 0);
+        for(int c = 0; c < clusters; c++) {
+            int r0 = (c / clusterCols) * clusterSize, c0 = (c % clusterCols) * clusterSize;
+            for(int r = r0; r < min(r0 + clusterSize, rows); r++) {
+                for(int col = c0; col < min(c0 + clusterSize, cols); col++) {
+                    int v = r * cols + col;
+                    for(int k: graph.neighborsOf(v)) {
+                        if(clusterOf(k) != c) {
+                            nodeCell.push_back(v);
+                            break;
+                        }
+                    }
+                }
+            }
+            clusterOffsets[c + 1] = nodeCell.size();
+        }
+        nodeCell.shrink_to_fit();
+
+        // edges across cluster borders and inside clusters
+        int nodes = nodeCell.size();
+        edgeOffsets.assign(nodes + 1, 0);
+        for(int n = 0; n < nodes; n++) {
+            int v = nodeCell[n], c = clusterOf(v);
+            for(int k: graph.neighborsOf(v)) {
+                if(clusterOf(k) != c) {
+                    edgeTarget.push_back(findNode(k));
+                    edgeCost.push_back(1);
+                }
+            }
+            searchCluster(segment, v);
+            for(int other = clusterOffsets[c]; other < clusterOffsets[c + 1]; other++) {
+                int dist = localDistance(segment, nodeCell[other]);
+                if(other != n && dist != -1) {
+                    edgeTarget.push_back(other);
+                    edgeCost.push_back((unsigned short)dist);
+                }
+            }
+            edgeOffsets[n + 1] = edgeTarget.size();
+        }
+        edgeTarget.shrink_to_fit();
+        edgeCost.shrink_to_fit();
+    }
+
+    int getNodes() const {
+        return nodeCell.size();
+    }
+
+    int getEdges() const {
+        return edgeTarget.size();
+    }
+
+    int getClusterSize() const {
+        return clusterSize;
+    }
+
+    // memory of the abstract graph, not counting the graph of the maze
+    size_t getMemoryBytes() const {
+        return bytesOf(clusterOffsets) + bytesOf(nodeCell) + bytesOf(edgeOffsets) + bytesOf(edgeTarget) + bytesOf(edgeCost);
+    }
+};
+
+// hierarchical path search for very large mazes on a ClusterGraph
+// a query only searches the clusters of the source and the destination cell-by-cell and the rest on the abstract graph,
+// then turns the abstract path back into cells, only the first part of it if that is all the caller needs
+// every shortest path goes from node to node this way, so the paths are as short as the ones from BFS
+// the engine owns only its search buffers when the cluster graph is shared
+class HPAStar : public PathFinder {
+
+private:
+
+    typedef ClusterGraph::LocalSearch LocalSearch;
+
+    // the cluster graph built by this engine, empty if it searches a shared one
+    unique_ptr<ClusterGraph> ownClusters;
+    const ClusterGraph* clusters;
+
+    LocalSearch fromSource;
+    LocalSearch toDest;
+    LocalSearch segment;
+
+    // abstract search, g and parent are only valid for nodes stamped with the current search
+    vector<int> g;
+    vector<int> parentNode;
+    vector<unsigned int> seen;
+    vector<unsigned int> closed;
+    unsigned int generation;
+    vector<pair<int, int> > heap;
+
+    // nodes of the last abstract path from the source side to the destination side, empty if the path stays in one cluster
+    vector<int> abstractPath;
+
+    // number of abstract nodes expanded by the last query
+    int expanded;
+
+    void allocate() {
+        clusters->resizeLocal(fromSource);
+        clusters->resizeLocal(toDest);
+        clusters->resizeLocal(segment);
+        int nodes = clusters->getNodes();
+        g.assign(nodes, 0);
+        parentNode.assign(nodes, -1);
+        seen.assign(nodes, 0);
+        closed.assign(nodes, 0);
+    }
+
+    // length of the shortest path from source to dest or -1, leaves the abstract path in abstractPath
+    int query(int source, int dest) {
+        const ClusterGraph &c = *clusters;
+        c.searchCluster(fromSource, source);
+        c.searchCluster(toDest, dest);
+        abstractPath.clear();
+        expanded = 0;
+
+        // a path that stays inside the cluster, it may still be longer than one that leaves it
+        int best = c.localDistance(fromSource, dest);
+        if(best == -1)
+            best = INT_MAX;
+        int bestNode = -1;
+
+        if(++generation == 0) {
+            seen.assign(seen.size(), 0);
+            closed.assign(closed.size(), 0);
+            generation = 1;
+        }
+        heap.clear();
+        for(int n = c.clusterOffsets[fromSource.cluster]; n < c.clusterOffsets[fromSource.cluster + 1]; n++) {
+            int dist = c.localDistance(fromSource, c.nodeCell[n]);
+            if(dist == -1)
+                continue;
+            seen[n] = generation;
+            g[n] = dist;
+            parentNode[n] = -1;
+            heap.push_back(make_pair(dist + c.heuristic(c.nodeCell[n], dest), n));
+        }
+        make_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+
+        while(!heap.empty() && heap.front().first < best) {
+            pop_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+            int f = heap.back().first, n = heap.back().second;
+            heap.pop_back();
+            if(closed[n] == generation || g[n] + c.heuristic(c.nodeCell[n], dest) != f)
+                continue;
+            closed[n] = generation;
+            expanded++;
+
+            int last = c.localDistance(toDest, c.nodeCell[n]);
+            if(last != -1 && g[n] + last < best) {
+                best = g[n] + last;
+                bestNode = n;
+            }
+
+            for(int e = c.edgeOffsets[n]; e < c.edgeOffsets[n + 1]; e++) {
+                int k = c.edgeTarget[e];
+                int next = g[n] + c.edgeCost[e];
+                if(seen[k] != generation || next < g[k]) {
+                    seen[k] = generation;
+                    g[k] = next;
+                    parentNode[k] = n;
+                    heap.push_back(make_pair(next + c.heuristic(c.nodeCell[k], dest), k));
+                    push_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+                }
+            }
+        }
+
+        if(best == INT_MAX)
+            return -1;
+        for(int n = bestNode; n != -1; n = parentNode[n])
+            abstractPath.push_back(n);
+        reverse(abstractPath.begin(), abstractPath.end());
+        return best;
+    }
+
+    // turn the result of query into cells
+    void refine(int dest, vector<int> &path) {
+        const ClusterGraph &c = *clusters;
+        if(abstractPath.empty()) {
+            c.appendFromStart(fromSource, dest, path);
+            return;
+        }
+        c.appendFromStart(fromSource, c.nodeCell[abstractPath[0]], path);
+        for(size_t i = 1; i < abstractPath.size(); i++) {
+            int from = c.nodeCell[abstractPath[i - 1]], to = c.nodeCell[abstractPath[i]];
+            if(c.clusterOf(from) != c.clusterOf(to)) {
+                path.push_back(to);
+            }else{
+                c.searchCluster(segment, from);
+                c.appendFromStart(segment, to, path);
+            }
+        }
+        c.appendToStart(toDest, c.nodeCell[abstractPath.back()], path);
+    }
+
+    template <typename T>
+    static size_t bytesOf(const vector<T> &v) {
+        return v.capacity() * sizeof(T);
+    }
+
+public:
+
+    static const int defaultClusterSize = ClusterGraph::defaultClusterSize;
+
+    // build the cluster graph and search on it
+    explicit HPAStar(const NavGraph &graph, int clusterSize = defaultClusterSize) : ownClusters(new ClusterGraph(graph, clusterSize)),
+            clusters(ownClusters.get()), generation(0), expanded(0) {
+        allocate();
+    }
+
+    // search on a cluster graph shared with other engines, it has to outlive the engine
+    explicit HPAStar(const ClusterGraph &clusters) : clusters(&clusters), generation(0), expanded(0) {
+        allocate();
+    }
+
+    bool getPath(int source, int dest, vector<int> &path) override {
+        path.clear();
+        if(source == dest || query(source, dest) == -1)
+            return false;
+        refine(dest, path);
+        return true;
+    }
+
+    const ClusterGraph& getClusters() const {
+        return *clusters;
+    }
+
+    int getNodes() const {
+        return clusters->getNodes();
+    }
+
+    int getEdges() const {
+        return clusters->getEdges();
+    }
+
+    int getExpanded() const {
+        return expanded;
+    }
+
+    // memory of the search buffers of this engine, every engine sharing the cluster graph has its own
+    size_t getSearchMemoryBytes() const {
+        size_t bytes = bytesOf(g) + bytesOf(parentNode) + bytesOf(seen) + bytesOf(closed) + bytesOf(heap) + bytesOf(abstractPath);
+        const LocalSearch* locals[3] = {&fromSource, &toDest, &segment};
+        for(int i = 0; i < 3; i++)
+            bytes += bytesOf(locals[i]->dist) + bytesOf(locals[i]->parent) + bytesOf(locals[i]->queue);
+        return bytes;
+    }
+
+    // memory used by the abstract graph and the search buffers, not counting the graph of the maze
+    size_t getMemoryBytes() const {
+        return clusters->getMemoryBytes() + getSearchMemoryBytes();
+    }
+
+    const char* getName() const override {
+        return "HPA*";
+    }
+};
+
+#endif // OPENGLPRJ_HPASTAR_H
@@ -0,0 +1,86 @@
+#ifndef OPENGLPRJ_KRUSKALGENERATOR_H
+#define OPENGLPRJ_KRUSKALGENERATOR_H
+#include <vector>
+#include "Generator.h"
+using namespace std;
+
+// randomized Kruskal's: every inner wall once, in random order, opened if the cells on its two sides are still apart
+// the parts of the maze are kept in a union-find with path compression and union by size, so a wall costs almost O(1)
+// makes a perfect maze with many short dead ends
+class KruskalGenerator : public Generator {
+private:
+    vector<int> parent;
+    vector<int> size;
+
+    // a wall is 2*cell for the wall right of the cell and 2*cell+1 for the wall below it
+    vector<int> walls;
+
+    size_t peakBytes;
+
+    int find(int v) {
+        int root = v;
+        while(parent[root] != root)
+            root = parent[root];
+        while(parent[v] != root) {
+            int next = parent[v];
+            parent[v] = root;
+            v = next;
+        }
+        return root;
+    }
+
+public:
+    KruskalGenerator() : peakBytes(0) {}
+
+    void carve(Grid &grid, Random &random) override {
+        int rows = grid.getRows(), cols = grid.getCols();
+        int V = rows * cols;
+
+        walls.clear();
+        walls.reserve(2 * V);
+        for(int v=0; v<V; v++) {
+            if(v % cols + 1 < cols)
+                walls.push_back(2 * v);
+            if(v / cols + 1 < rows)
+                walls.push_back(2 * v + 1);
+        }
+        for(int k=(int)walls.size()-1; k>0; k--)
+            swap(walls[k], walls[random.below(k + 1)]);
+
+        parent.resize(V);
+        size.assign(V, 1);
+        for(int v=0; v<V; v++)
+            parent[v] = v;
+
+        // a spanning tree has V-1 passages, the rest of the walls can't open anything
+        int passages = 0;
+        for(size_t k=0; k<walls.size() && passages < V - 1; k++) {
+            int a = walls[k] / 2;
+            int b = walls[k] % 2 == 0 ? a + 1 : a + cols;
+            int ra = find(a), rb = find(b);
+            if(ra == rb)
+                continue;
+            if(size[ra] < size[rb])
+                swap(ra, rb);
+            parent[rb] = ra;
+            size[ra] += size[rb];
+            openWall(grid, a, b);
+            passages++;
+        }
+
+        peakBytes = (walls.capacity() + parent.capacity() + size.capacity()) * sizeof(int);
+        vector<int>().swap(walls);
+        vector<int>().swap(parent);
+        vector<int>().swap(size);
+    }
+
+    size_t getPeakMemoryBytes() const override {
+        return peakBytes;
+    }
+
+    const char* getName() const override {
+        return "kruskal";
+    }
+};
+
+#endif // OPENGLPRJ_KRUSKALGENERATOR_H
@@ -0,0 +1,106 @@
+#ifndef OPENGLPRJ_LANDMARKS_H
+#define OPENGLPRJ_LANDMARKS_H
+#include <vector>
+#include <climits>
+#include <cstdlib>
+#include "NavGraph.h"
+using namespace std;
+
+// distances from a few landmark cells to every cell, computed once per maze
+// for any landmark L the triangle inequality gives dist(v, dest) >= |dist(L, dest) - dist(L, v)|,
+// which follows the walls of the maze and is much closer to the real distance than the manhattan distance
+// landmarks are chosen one by one as the cell farthest from all landmarks chosen before,
+// so they end up in the corners and dead ends that paths lead towards
+class Landmarks {
+
+private:
+
+    int V;
+    int count;
+    vector<int> landmarks;
+
+    // the distances of one cell to all landmarks are next to each other: distance[v*count + i]
+    vector<int> distance;
+
+public:
+
+    static const int unreachable = -1;
+
+    Landmarks() : V(0), count(0) {}
+
+    Landmarks(const NavGraph &graph, int count) : V(graph.getV()), count(count < V ? count : V) {
+        distance.assign((size_t)V * this->count, (int)unreachable);
+        if(this->count == 0)
+            return;
+        vector<int> nearest(V, INT_MAX);
+        vector<int> dist(V);
+        vector<int> queue(V);
+
+        // the first landmark is the cell farthest from cell 0
+        int next = 0;
+        for(int i = -1; i < this->count; i++) {
+            dist.assign(V, (int)unreachable);
+            int head = 0, tail = 0;
+            queue[tail++] = next;
+            dist[next] = 0;
+            while(head < tail) {
+                int temp = queue[head++];
+                for(int k: graph.neighborsOf(temp)) {
+                    if(dist[k] == unreachable) {
+                        dist[k] = dist[temp] + 1;
+                        queue[tail++] = k;
+                    }
+                }
+            }
+
+            if(i == -1) {
+                nearest = dist;
+            }else{
+                landmarks.push_back(next);
+                for(int v = 0; v < V; v++) {
+                    distance[(size_t)v * this->count + i] = dist[v];
+                    if(dist[v] != unreachable && (i == 0 || dist[v] < nearest[v]))
+                        nearest[v] = dist[v];
+                }
+            }
+
+            // next landmark, the reachable cell farthest from the landmarks so far
+            for(int v = 0; v < V; v++)
+                if(dist[v] != unreachable && nearest[v] > nearest[next])
+                    next = v;
+        }
+    }
+
+    int getCount() const {
+        return count;
+    }
+
+    int getLandmark(int i) const {
+        return landmarks[i];
+    }
+
+    // distances of cell to every landmark, to be kept for the destination of a search
+    const int* distancesOf(int cell) const {
+        return &distance[(size_t)cell * count];
+    }
+
+    // lower bound of the distance from cell to the cell the distances belong to
+    int lowerBound(int cell, const int* destDistances) const {
+        const int* cellDistances = distancesOf(cell);
+        int bound = 0;
+        for(int i = 0; i < count; i++) {
+            if(cellDistances[i] != unreachable && destDistances[i] != unreachable) {
+                int d = abs(cellDistances[i] - destDistances[i]);
+                if(d > bound)
+                    bound = d;
+            }
+        }
+        return bound;
+    }
+
+    size_t getMemoryBytes() const {
+        return distance.capacity() * sizeof(int) + landmarks.capacity() * sizeof(int);
+    }
+};
+
+#endif // OPENGLPRJ_LANDMARKS_H
@@ -0,0 +1,273 @@
+#ifndef OPENGLPRJ_LEVELFILE_H
+#define OPENGLPRJ_LEVELFILE_H
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+#include "Generator.h"
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// header at the start of a level file, all numbers little-endian
+// the header is followed by the ghost spawn cells (uint32 each, padded to 8 bytes) and four bitplanes of planeWords
+// 64 bit words each: wall right, wall down, coin and powerup, one bit per cell in the order of the grid
+// up and left walls aren't stored, they are the down and right walls of the neighbors, or the border
+struct LevelHeader {
+    char magic[4];          // "PMLV"
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint64_t seed;          // seed the maze was generated from
+    uint32_t generator;     // MazeGenerator that made it
+    uint32_t ghostCount;
+    uint64_t planeWords;
+};
+
+// a level file mapped into memory: nothing is parsed or copied when it is opened,
+// the cells are read straight from the mapped bitplanes, unpack() fills a grid for the game
+// the navigation graph isn't stored, its edges would make a file about 25 times larger than the four planes,
+// Maze(level) builds it from the unpacked grid, which is most of the time a large level takes to load
+class LevelFile {
+private:
+    const unsigned char *data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    const LevelHeader *header;
+    const uint32_t *spawns;
+    const uint64_t *planes[4];
+
+    enum Plane {
+        PLANE_WALL_RIGHT,
+        PLANE_WALL_DOWN,
+        PLANE_COIN,
+        PLANE_POWERUP
+    };
+
+    static size_t spawnBytes(uint32_t ghostCount) {
+        return (ghostCount * sizeof(uint32_t) + 7) / 8 * 8;
+    }
+
+    bool bit(Plane plane, int v) const {
+        return (planes[plane][v >> 6] >> (v & 63)) & 1;
+    }
+
+    // bit k of a byte moved to the lowest bit of byte k of a little-endian word, for every byte
+    struct SpreadTable {
+        uint64_t words[256];
+        SpreadTable() {
+            for(int b=0; b<256; b++) {
+                words[b] = 0;
+                for(int k=0; k<8; k++)
+                    if(b & (1 << k))
+                        words[b] |= (uint64_t)1 << (8 * k);
+            }
+        }
+    };
+
+    static const uint64_t* spreadTable() {
+        static const SpreadTable table;
+        return table.words;
+    }
+
+    // 64 bits of a plane from any bit on, bits before the start of the plane are 0
+    uint64_t bitsAt(const uint64_t *plane, long long start) const {
+        if(start <= -64)
+            return 0;
+        if(start < 0)
+            return plane[0] << -start;
+        size_t word = start >> 6, shift = start & 63;
+        uint64_t value = plane[word] >> shift;
+        if(shift != 0 && word + 1 < header->planeWords)
+            value |= plane[word + 1] << (64 - shift);
+        return value;
+    }
+
+    void unmap() {
+        if(data == nullptr)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+        CloseHandle(file);
+#else
+        munmap((void*)data, size);
+#endif
+        data = nullptr;
+        header = nullptr;
+    }
+
+public:
+    static const uint32_t currentVersion = 1;
+
+    LevelFile() : data(nullptr), size(0), header(nullptr), spawns(nullptr) {}
+
+    ~LevelFile() {
+        unmap();
+    }
+
+    LevelFile(const LevelFile&) = delete;
+    LevelFile& operator=(const LevelFile&) = delete;
+
+    // map a level file, returns false if it can't be read or isn't a level of this version
+    bool open(const char *path) {
+        unmap();
+#ifdef _WIN32
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        size = (size_t)fileSize.QuadPart;
+        mapping = size == 0 ? nullptr : CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping == nullptr) {
+            CloseHandle(file);
+            return false;
+        }
+        data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(data == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+#else
+        int fd = ::open(path, O_RDONLY);
+        if(fd < 0)
+            return false;
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        size = (size_t)info.st_size;
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if(mapped == MAP_FAILED)
+            return false;
+        data = (const unsigned char*)mapped;
+#endif
+
+        // only the header and the spawn cells are checked, the planes are used as they are
+        header = (const LevelHeader*)data;
+        if(size < sizeof(LevelHeader) || memcmp(header->magic, "PMLV", 4) != 0 || header->version != currentVersion
+           || header->rows > (uint32_t)Grid::maxSide || header->cols > (uint32_t)Grid::maxSide
+           || header->planeWords != ((uint64_t)header->rows * header->cols + 63) / 64
+           || size < sizeof(LevelHeader) + spawnBytes(header->ghostCount) + 4 * header->planeWords * sizeof(uint64_t)) {
+            unmap();
+            return false;
+        }
+        spawns = (const uint32_t*)(data + sizeof(LevelHeader));
+        const uint64_t *plane = (const uint64_t*)(data + sizeof(LevelHeader) + spawnBytes(header->ghostCount));
+        for(int p=0; p<4; p++)
+            planes[p] = plane + p * header->planeWords;
+        for(uint32_t i=0; i<header->ghostCount; i++) {
+            if(spawns[i] >= (uint64_t)header->rows * header->cols) {
+                unmap();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+
+    int getRows() const { return header->rows; }
+    int getCols() const { return header->cols; }
+    uint64_t getSeed() const { return header->seed; }
+    MazeGenerator getGenerator() const { return (MazeGenerator)header->generator; }
+    int getGhostCount() const { return header->ghostCount; }
+    int getGhostSpawn(int ghost) const { return spawns[ghost]; }
+    size_t getFileBytes() const { return size; }
+
+    bool wallRight(int v) const { return bit(PLANE_WALL_RIGHT, v); }
+    bool wallDown(int v) const { return bit(PLANE_WALL_DOWN, v); }
+    bool wallUp(int v) const { return v < (int)header->cols || bit(PLANE_WALL_DOWN, v - header->cols); }
+    bool wallLeft(int v) const { return v % header->cols == 0 || bit(PLANE_WALL_RIGHT, v - 1); }
+    bool hasCoin(int v) const { return bit(PLANE_COIN, v); }
+    bool hasPowerup(int v) const { return bit(PLANE_POWERUP, v); }
+
+    // the cells of the level, the grid gets the level's size
+    // 64 cells at a time: the up and left walls are the down and right planes shifted by a row and by a cell,
+    // then the walls on the border of the maze are closed whatever the file says
+    void unpack(Grid &grid) const {
+        int rows = header->rows, cols = header->cols;
+        size_t V = (size_t)rows * cols;
+        grid.resize(rows, cols);
+        const uint64_t *right = planes[PLANE_WALL_RIGHT], *down = planes[PLANE_WALL_DOWN];
+        const uint64_t *coin = planes[PLANE_COIN], *powerup = planes[PLANE_POWERUP];
+        const uint64_t *spread = spreadTable();
+        for(size_t w=0; w<header->planeWords; w++) {
+            long long v = w * 64;
+            uint64_t left = bitsAt(right, v - 1), up = bitsAt(down, v - cols);
+            // 8 cells per step: every plane byte is spread to one byte per cell and the bytes are added up
+            size_t count = V - v < 64 ? V - v : 64;
+            unsigned char cells[64];
+            for(int k=0; k<64; k+=8) {
+                uint64_t bytes = spread[(right[w] >> k) & 255] * Cell::WALL_RIGHT + spread[(down[w] >> k) & 255] * Cell::WALL_DOWN
+                    + spread[(left >> k) & 255] * Cell::WALL_LEFT + spread[(up >> k) & 255] * Cell::WALL_UP
+                    + spread[(coin[w] >> k) & 255] * Cell::COIN + spread[(powerup[w] >> k) & 255] * Cell::POWERUP;
+                memcpy(cells + k, &bytes, 8);
+            }
+            memcpy(&grid.at(v), cells, count);
+        }
+        for(int i=0; i<rows; i++) {
+            grid[i][0].setWallLeft(true);
+            grid[i][cols-1].setWallRight(true);
+        }
+        for(int j=0; j<cols; j++) {
+            grid[0][j].setWallUp(true);
+            grid[rows-1][j].setWallDown(true);
+        }
+    }
+
+    // write a grid as a level file, returns false if the file can't be written
+    static bool save(const char *path, const Grid &grid, uint64_t seed, MazeGenerator generator, const vector<int> &ghostSpawns) {
+        LevelHeader out;
+        memcpy(out.magic, "PMLV", 4);
+        out.version = currentVersion;
+        out.rows = grid.getRows();
+        out.cols = grid.getCols();
+        out.seed = seed;
+        out.generator = generator;
+        out.ghostCount = ghostSpawns.size();
+        out.planeWords = ((uint64_t)out.rows * out.cols + 63) / 64;
+
+        vector<uint32_t> spawnCells(spawnBytes(out.ghostCount) / sizeof(uint32_t), 0);
+        for(size_t i=0; i<ghostSpawns.size(); i++)
+            spawnCells[i] = ghostSpawns[i];
+
+        vector<uint64_t> bits(4 * out.planeWords, 0);
+        for(size_t v=0; v<grid.size(); v++) {
+            const Cell &cell = grid.at(v);
+            uint64_t mask = (uint64_t)1 << (v & 63);
+            if(cell.wallRight()) bits[PLANE_WALL_RIGHT * out.planeWords + (v >> 6)] |= mask;
+            if(cell.wallDown()) bits[PLANE_WALL_DOWN * out.planeWords + (v >> 6)] |= mask;
+            if(cell.hasCoin()) bits[PLANE_COIN * out.planeWords + (v >> 6)] |= mask;
+            if(cell.hasPowerup()) bits[PLANE_POWERUP * out.planeWords + (v >> 6)] |= mask;
+        }
+
+        FILE *file = fopen(path, "wb");
+        if(file == nullptr)
+            return false;
+        bool written = fwrite(&out, sizeof(out), 1, file) == 1
+            && (spawnCells.empty() || fwrite(spawnCells.data(), sizeof(uint32_t), spawnCells.size(), file) == spawnCells.size())
+            && fwrite(bits.data(), sizeof(uint64_t), bits.size(), file) == bits.size();
+        return fclose(file) == 0 && written;
+    }
+};
+
+#endif // OPENGLPRJ_LEVELFILE_H
@@ -5,162 +5,187 @@
 #include <queue>
 #include <ctime>
 #include <cstdlib>
-#include "Cell.h"
+#include "Grid.h"
+#include "Random.h"
+#include <memory>
+#include "Generator.h"
+#include "PrimGenerator.h"
+#include "EllerGenerator.h"
+#include "TiledGenerator.h"
+#include "KruskalGenerator.h"
+#include "WilsonGenerator.h"
+#include "BacktrackerGenerator.h"
+#include "LevelFile.h"
+#include "PickupSet.h"
+#include "NavGraph.h"
 
 using namespace std;
 
-const int rows = 10;
-const int cols = 10;
+// size of the game's maze, 10x10 unless another size is set before the maze is created
+int rows = 10;
+int cols = 10;
 
-vector<vector<Cell>> maze(rows, vector<Cell>(cols));
+// the smallest maze that has room for all powerups
+const int minMazeSize = 5;
 
+// set the size of the mazes created from now on, sides below the minimum are raised to it
+// returns false and keeps the size if a side is longer than a grid can be
+bool setMazeSize(int newRows, int newCols) {
+    if(newRows > Grid::maxSide || newCols > Grid::maxSide)
+        return false;
+    rows = newRows < minMazeSize ? minMazeSize : newRows;
+    cols = newCols < minMazeSize ? minMazeSize : newCols;
+    return true;
+}
+
+// a maze with its own grid and random number generator, so the same seed always makes the same maze
+// and mazes can be generated on several threads at once
 class Maze {
+private:
+
+    // size of this maze, the same as the globals for the game's maze
+    int rows;
+    int cols;
+
+    Random random;
+
+    MazeGenerator generator;
+
 public:
 
-    Maze(){
+    // cells of the maze, filled by generateMaze()
+    Grid grid;
+
+    // graph of the passages, rebuilt by generateMaze() and shared by everything that searches the maze
+    NavGraph graph;
+
+    // coins and powerups still in the maze; the cells keep where they were when the maze was made,
+    // the game takes pickups from these sets only
+    PickupSet coins;
+    PickupSet powerups;
+
+    // maze of the game's size with a seed that is different every run
+    Maze() : Maze(::rows, ::cols, Random::randomSeed()) {}
+
+    Maze(int rows, int cols, uint64_t seed, MazeGenerator generator = GENERATOR_PRIM)
+        : Maze(rows, cols, Random(seed), generator) {}
+
+    // the maze draws all its random numbers from the given generator
+    Maze(int rows, int cols, const Random &random, MazeGenerator generator = GENERATOR_PRIM)
+        : rows(rows), cols(cols), random(random), generator(generator) {
         initializeGrid();
     }
 
+    // maze of a level file, the cells come from the file instead of a generator
+    explicit Maze(const LevelFile &level)
+        : rows(level.getRows()), cols(level.getCols()), random(level.getSeed()), generator(level.getGenerator()) {
+        level.unpack(grid);
+        graph.build(grid);
+        collectPickups();
+    }
+
+    // write the maze as it is now to a level file
+    bool saveLevel(const char *path, const vector<int> &ghostSpawns) const {
+        return LevelFile::save(path, grid, getSeed(), generator, ghostSpawns);
+    }
+
+    uint64_t getSeed() const {
+        return random.getSeed();
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    MazeGenerator getGenerator() const { return generator; }
+
+    // the generator used by the next generateMaze()
+    void setGenerator(MazeGenerator newGenerator) {
+        generator = newGenerator;
+    }
+
     void initializeGrid() {
+        grid.resize(rows, cols);
 
         //initialize maze full of walls
         for (int i = 0; i < rows; ++i) {
             for (int j = 0; j < cols; ++j) {
-                maze[i][j].row = i;
-                maze[i][j].col = j;
-                maze[i][j].visited = false;
-                maze[i][j].wallUp = true;
-                maze[i][j].wallDown = true;
-                maze[i][j].wallLeft = true;
-                maze[i][j].wallRight = true;
-                maze[i][j].hasCoin = true;
-                maze[i][j].hasPowerup = false;
+                grid[i][j].closeAll();
+                grid[i][j].setCoin(true);
             }
         }
 
         // add powerup
-        maze[0][0].hasPowerup = true;
-        maze[0][cols-1].hasPowerup = true;
-        maze[rows-1][0].hasPowerup = true;
-        maze[rows-1][cols-1].hasPowerup = true;
-        maze[2][2].hasPowerup = true;
-        maze[2][cols-3].hasPowerup = true;
-        maze[rows-3][2].hasPowerup = true;
-        maze[rows-3][cols-3].hasPowerup = true;
+        grid[0][0].setPowerup(true);
+        grid[0][cols-1].setPowerup(true);
+        grid[rows-1][0].setPowerup(true);
+        grid[rows-1][cols-1].setPowerup(true);
+        grid[2][2].setPowerup(true);
+        grid[2][cols-3].setPowerup(true);
+        grid[rows-3][2].setPowerup(true);
+        grid[rows-3][cols-3].setPowerup(true);
 
         // delete coins on cells that have powerups
-        maze[0][0].hasCoin = false;
-        maze[0][cols-1].hasCoin = false;
-        maze[rows-1][0].hasCoin = false;
-        maze[rows-1][cols-1].hasCoin = false;
-        maze[2][2].hasCoin = false;
-        maze[2][cols-3].hasCoin = false;
-        maze[rows-3][2].hasCoin = false;
-        maze[rows-3][cols-3].hasCoin = false;
+        grid[0][0].setCoin(false);
+        grid[0][cols-1].setCoin(false);
+        grid[rows-1][0].setCoin(false);
+        grid[rows-1][cols-1].setCoin(false);
+        grid[2][2].setCoin(false);
+        grid[2][cols-3].setCoin(false);
+        grid[rows-3][2].setCoin(false);
+        grid[rows-3][cols-3].setCoin(false);
     }
 
     bool isNotVisited(int row, int col) {
-        return (row >= 0 && row < rows && col >= 0 && col < cols && !maze[row][col].visited);
+        return (row >= 0 && row < rows && col >= 0 && col < cols && !grid[row][col].isVisited());
     }
 
     bool isVisited(int row, int col){
-        return (row >= 0 && row < rows && col >= 0 && col < cols && maze[row][col].visited);
-    }
-
-    bool contains(vector<pair<int, int>> walls, int row, int col){
-        for(pair<int,int> wall: walls)
-            if(wall.first==row && wall.second==col)
-                return true;
-        return false;
+        return (row >= 0 && row < rows && col >= 0 && col < cols && grid[row][col].isVisited());
     }
 
-    void addNeighbor(int currentRow, int currentCol, int neighborRow, int neighborCol) const {
+    void addNeighbor(int currentRow, int currentCol, int neighborRow, int neighborCol) {
         if (neighborRow == currentRow - 1) {
-            maze[currentRow][currentCol].wallUp = false;
-            maze[neighborRow][neighborCol].wallDown = false;
+            grid[currentRow][currentCol].setWallUp(false);
+            grid[neighborRow][neighborCol].setWallDown(false);
         } else if (neighborRow == currentRow + 1) {
-            maze[currentRow][currentCol].wallDown = false;
-            maze[neighborRow][neighborCol].wallUp = false;
+            grid[currentRow][currentCol].setWallDown(false);
+            grid[neighborRow][neighborCol].setWallUp(false);
         } else if (neighborCol == currentCol - 1) {
-            maze[currentRow][currentCol].wallLeft = false;
-            maze[neighborRow][neighborCol].wallRight = false;
+            grid[currentRow][currentCol].setWallLeft(false);
+            grid[neighborRow][neighborCol].setWallRight(false);
         } else if (neighborCol == currentCol + 1) {
-            maze[currentRow][currentCol].wallRight = false;
-            maze[neighborRow][neighborCol].wallLeft = false;
+            grid[currentRow][currentCol].setWallRight(false);
+            grid[neighborRow][neighborCol].setWallLeft(false);
+        }
+    }
+
+    // the generator for a strategy, Eller's and the tiles get the game's loops
+    static Generator* createGenerator(MazeGenerator generator) {
+        switch (generator) {
+            case GENERATOR_ELLER: return new EllerMazeGenerator(ellerLoopChance);
+            case GENERATOR_TILED: return new TiledGenerator(256, 0, ellerLoopChance);
+            case GENERATOR_KRUSKAL: return new KruskalGenerator();
+            case GENERATOR_WILSON: return new WilsonGenerator();
+            case GENERATOR_BACKTRACKER: return new BacktrackerGenerator();
+            default: return new PrimGenerator();
         }
     }
 
     void generateMaze() {
+        unique_ptr<Generator> carver(createGenerator(generator));
+        carver->carve(grid, random);
+        graph.build(grid);
+        collectPickups();
+    }
 
-        // generate random column and row
-        int startRow = rand() % rows;
-        int startCol = rand() % cols;
-
-        // mark cell as visited
-        maze[startRow][startCol].visited = true;
-        vector<pair<int, int>> unvisitedCells;
-
-        // add unvisited neighbors to list
-        if (isNotVisited(startRow - 1, startCol)) unvisitedCells.push_back(make_pair(startRow - 1, startCol));
-        if (isNotVisited(startRow + 1, startCol)) unvisitedCells.push_back(make_pair(startRow + 1, startCol));
-        if (isNotVisited(startRow, startCol - 1)) unvisitedCells.push_back(make_pair(startRow, startCol - 1));
-        if (isNotVisited(startRow, startCol + 1)) unvisitedCells.push_back(make_pair(startRow, startCol + 1));
-
-        // loop while unvisited cells list is full
-        while (!unvisitedCells.empty()) {
-            // choose a cell
-            int randomIndex = rand() % unvisitedCells.size();
-            int currentRow = unvisitedCells[randomIndex].first;
-            int currentCol = unvisitedCells[randomIndex].second;
-            maze[currentRow][currentCol].visited = true;
-
-            // current cells neighbors
-            vector<pair<int, int>> neighbors;
-
-            // add all visited neighboring cells
-            if (isVisited(currentRow - 1, currentCol)) neighbors.push_back(make_pair(currentRow - 1, currentCol));
-            if (isVisited(currentRow + 1, currentCol)) neighbors.push_back(make_pair(currentRow + 1, currentCol));
-            if (isVisited(currentRow, currentCol - 1)) neighbors.push_back(make_pair(currentRow, currentCol - 1));
-            if (isVisited(currentRow, currentCol + 1)) neighbors.push_back(make_pair(currentRow, currentCol + 1));
-
-            // pick a random neighbor to connect to
-            if (!neighbors.empty()) {
-                // randomly connect to 2 neighbors
-                int random = rand() % 100;
-                if(random >= 30){
-                    if(neighbors.size() > 1){
-                        for(int i=0;i<2;i++){
-                            int randomNeighborIndex = rand() % neighbors.size();
-                            int neighborRow = neighbors[randomNeighborIndex].first;
-                            int neighborCol = neighbors[randomNeighborIndex].second;
-
-                            addNeighbor(currentRow, currentCol, neighborRow, neighborCol);
-                            neighbors.erase(neighbors.begin() + randomNeighborIndex);
-                        }
-                    }else{
-                        int randomNeighborIndex = rand() % neighbors.size();
-                        int neighborRow = neighbors[randomNeighborIndex].first;
-                        int neighborCol = neighbors[randomNeighborIndex].second;
-
-                        addNeighbor(currentRow, currentCol, neighborRow, neighborCol);
-                    }
-                }else{
-                    int randomNeighborIndex = rand() % neighbors.size();
-                    int neighborRow = neighbors[randomNeighborIndex].first;
-                    int neighborCol = neighbors[randomNeighborIndex].second;
-
-                    addNeighbor(currentRow, currentCol, neighborRow, neighborCol);
-                }
-            }
-            // erase current cell from list
-            unvisitedCells.erase(unvisitedCells.begin() + randomIndex);
-
-            // add all new unvisited neighbors
-            if (isNotVisited(currentRow - 1, currentCol) && !contains(unvisitedCells,currentRow - 1, currentCol)) unvisitedCells.push_back(make_pair(currentRow - 1, currentCol));
-            if (isNotVisited(currentRow + 1, currentCol) && !contains(unvisitedCells,currentRow + 1, currentCol)) unvisitedCells.push_back(make_pair(currentRow + 1, currentCol));
-            if (isNotVisited(currentRow, currentCol - 1) && !contains(unvisitedCells,currentRow, currentCol-1)) unvisitedCells.push_back(make_pair(currentRow, currentCol - 1));
-            if (isNotVisited(currentRow, currentCol + 1) && !contains(unvisitedCells,currentRow, currentCol+1)) unvisitedCells.push_back(make_pair(currentRow, currentCol + 1));
-        }
+    // fill the pickup sets from the cells
+    void collectPickups() {
+        coins.fill(grid, false);
+        powerups.fill(grid, true);
+    }
+
+    size_t remainingPickups() const {
+        return coins.count() + powerups.count();
     }
 };
 
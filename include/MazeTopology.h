@@ -0,0 +1,247 @@
+#ifndef OPENGLPRJ_MAZETOPOLOGY_H
+#define OPENGLPRJ_MAZETOPOLOGY_H
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include "NavGraph.h"
+using namespace std;
+
+// a dead end and the corridor cells behind it, up to the cell where the chain leaves the corridor
+struct DeadEndChain {
+    int deadEnd;
+    // cells of the chain, the dead end included and the exit not
+    int length;
+    // first cell with more than two passages, -1 if the chain ends in another dead end
+    int exit;
+};
+
+// structure of a maze, found on demand (the --stats report and the benches) and then only read, the game doesn't build it
+// per cell: the number of passages, the connected component, the dead end chain it is on and whether it is an
+// articulation point (removing it splits the maze); per passage: whether it is a bridge (closing it splits the maze)
+// all of it comes from one pass over the cells and one depth first search with an explicit stack, linear in the cells
+class MazeTopology {
+
+private:
+
+    enum Flags {
+        ARTICULATION = 1,
+        BRIDGE_DOWN = 2,
+        BRIDGE_RIGHT = 4
+    };
+
+    int V;
+    int cols;
+
+    vector<unsigned char> degrees;
+    vector<unsigned char> flags;
+    vector<int> component;
+
+    // dead end chain of each cell, -1 for cells that aren't on one
+    vector<int> chainOf;
+
+    vector<int> junctions;
+    vector<DeadEndChain> chains;
+
+    int components;
+    long long passages;
+    long long loops;
+    int articulationPoints;
+    long long bridges;
+    int deadEnds;
+    int longestChain;
+
+    // passages are marked on the cell above or left of them
+    void markBridge(int a, int b) {
+        if(a > b)
+            swap(a, b);
+        flags[a] |= b == a + cols ? BRIDGE_DOWN : BRIDGE_RIGHT;
+        bridges++;
+    }
+
+    // the chain from a dead end, every cell with two passages is walked until the corridor ends
+    void walkChain(const NavGraph &graph, int deadEnd) {
+        DeadEndChain chain;
+        chain.deadEnd = deadEnd;
+        chain.length = 1;
+        chain.exit = -1;
+        int id = chains.size();
+        chainOf[deadEnd] = id;
+        int previous = deadEnd, current = *graph.neighborsOf(deadEnd).begin();
+        while(degrees[current] == 2) {
+            chainOf[current] = id;
+            chain.length++;
+            int next = *graph.neighborsOf(current).begin();
+            if(next == previous)
+                next = *(graph.neighborsOf(current).begin() + 1);
+            previous = current;
+            current = next;
+        }
+        if(degrees[current] == 1) {
+            chainOf[current] = id;
+            chain.length++;
+        }else{
+            chain.exit = current;
+        }
+        longestChain = max(longestChain, chain.length);
+        chains.push_back(chain);
+    }
+
+    // Tarjan's search for articulation points and bridges, which also numbers the components
+    // the cells of the current path are on an explicit stack, the parent of a cell is the entry below it, and an entry
+    // keeps the low number of its cell and how many of its passages it has tried, so the only memory per cell is the
+    // order the cells were found in; the orders are stamped like SearchWorkspace's visited marks: a build goes on counting
+    // from where the last one stopped, cells with a lower order are unvisited and a rebuild doesn't clear anything
+    struct PathEntry {
+        // cell * 8 + passages tried, a cell has at most four and 2^28 cells still fit
+        unsigned int cellTried;
+        int low;
+    };
+
+    vector<int> order;
+    vector<PathEntry> path;
+    int time;
+
+    void search(const NavGraph &graph) {
+        // the orders are cleared only when the maze changes size or the count would run out
+        if((int)order.size() != V || time > INT_MAX - V) {
+            order.assign(V, 0);
+            time = 0;
+        }
+        int first = time;
+        for(int root=0; root<V; root++) {
+            if(order[root] > first)
+                continue;
+            int rootChildren = 0;
+            order[root] = ++time;
+            component[root] = components;
+            PathEntry start = {(unsigned int)root * 8, time};
+            path.push_back(start);
+            while(!path.empty()) {
+                PathEntry &top = path.back();
+                int v = top.cellTried >> 3, tried = top.cellTried & 7;
+                NavGraph::Neighbors next = graph.neighborsOf(v);
+                if(tried < next.size()) {
+                    top.cellTried++;
+                    int w = next.first[tried];
+                    if(order[w] <= first) {
+                        order[w] = ++time;
+                        component[w] = components;
+                        if(v == root)
+                            rootChildren++;
+                        PathEntry entry = {(unsigned int)w * 8, time};
+                        path.push_back(entry);
+                    }else if(path.size() < 2 || (int)(path[path.size() - 2].cellTried >> 3) != w) {
+                        top.low = min(top.low, order[w]);
+                    }
+                }else{
+                    int low = top.low;
+                    path.pop_back();
+                    if(path.empty())
+                        continue;
+                    PathEntry &parent = path.back();
+                    int p = parent.cellTried >> 3;
+                    parent.low = min(parent.low, low);
+                    if(low > order[p])
+                        markBridge(p, v);
+                    if(p != root && low >= order[p])
+                        flags[p] |= ARTICULATION;
+                }
+            }
+            if(rootChildren > 1)
+                flags[root] |= ARTICULATION;
+            components++;
+        }
+    }
+
+public:
+
+    MazeTopology() : V(0), cols(0), components(0), passages(0), loops(0), articulationPoints(0), bridges(0),
+                     deadEnds(0), longestChain(0), time(0) {}
+
+    explicit MazeTopology(const NavGraph &graph) : MazeTopology() {
+        build(graph);
+    }
+
+    void build(const NavGraph &graph) {
+        V = graph.getV();
+        cols = graph.getCols();
+        degrees.assign(V, 0);
+        flags.assign(V, 0);
+        component.assign(V, 0);
+        chainOf.assign(V, -1);
+        junctions.clear();
+        chains.clear();
+        components = 0;
+        passages = 0;
+        bridges = 0;
+        articulationPoints = 0;
+        deadEnds = 0;
+        longestChain = 0;
+
+        for(int v=0; v<V; v++) {
+            degrees[v] = graph.degree(v);
+            passages += degrees[v];
+            if(degrees[v] >= 3)
+                junctions.push_back(v);
+        }
+        passages /= 2;
+
+        // a corridor with dead ends at both sides is one chain, found from its first dead end
+        for(int v=0; v<V; v++) {
+            if(degrees[v] == 1) {
+                deadEnds++;
+                if(chainOf[v] < 0)
+                    walkChain(graph, v);
+            }
+        }
+
+        search(graph);
+        for(int v=0; v<V; v++)
+            if(flags[v] & ARTICULATION)
+                articulationPoints++;
+
+        // every component is a spanning tree plus one passage per loop
+        loops = passages - V + components;
+    }
+
+    int getV() const { return V; }
+
+    int degree(int v) const { return degrees[v]; }
+    bool isDeadEnd(int v) const { return degrees[v] == 1; }
+    bool isJunction(int v) const { return degrees[v] >= 3; }
+    bool isArticulation(int v) const { return flags[v] & ARTICULATION; }
+
+    // whether the passage between two neighboring cells is a bridge
+    bool isBridge(int a, int b) const {
+        if(a > b)
+            swap(a, b);
+        return flags[a] & (b == a + cols ? BRIDGE_DOWN : BRIDGE_RIGHT);
+    }
+
+    int getComponent(int v) const { return component[v]; }
+    bool isConnected(int a, int b) const { return component[a] == component[b]; }
+
+    // dead end chain of a cell, -1 if it isn't on one
+    int getChain(int v) const { return chainOf[v]; }
+    const DeadEndChain& chain(int id) const { return chains[id]; }
+
+    const vector<int>& getJunctions() const { return junctions; }
+    const vector<DeadEndChain>& getChains() const { return chains; }
+
+    int getComponents() const { return components; }
+    long long getPassages() const { return passages; }
+    long long getLoops() const { return loops; }
+    int getArticulationPoints() const { return articulationPoints; }
+    long long getBridges() const { return bridges; }
+    int getDeadEnds() const { return deadEnds; }
+    int getLongestChain() const { return longestChain; }
+
+    // the results and the search memory kept for the next build
+    size_t getMemoryBytes() const {
+        return degrees.capacity() + flags.capacity()
+            + (component.capacity() + chainOf.capacity() + junctions.capacity() + order.capacity()) * sizeof(int)
+            + chains.capacity() * sizeof(DeadEndChain) + path.capacity() * sizeof(PathEntry);
+    }
+};
+
+#endif // OPENGLPRJ_MAZETOPOLOGY_H
@@ -0,0 +1,103 @@
+#ifndef OPENGLPRJ_NAVGRAPH_H
+#define OPENGLPRJ_NAVGRAPH_H
+#include <vector>
+#include "Grid.h"
+using namespace std;
+
+// navigation graph of the maze in compressed sparse row form
+// the neighbors of cell v are neighbors[offsets[v]] .. neighbors[offsets[v+1]-1], ordered up, down, left, right
+// it is built once when the maze is generated and then only read, so all ghosts can share it
+class NavGraph {
+
+private:
+
+    int V;
+    int rows;
+    int cols;
+
+    vector<int> offsets;
+    vector<int> neighbors;
+
+    // open sides of a cell as the low four bits of Cell (up, down, left, right), sides on the border are never open
+    static int openSides(const Cell &cell, int borderMask) {
+        return ~cell.getBits() & borderMask;
+    }
+
+    // sides that can be open in column j of a row whose up and down sides are rowMask
+    int borderMask(int rowMask, int j) const {
+        return rowMask | (j > 0 ? Cell::WALL_LEFT : 0) | (j < cols-1 ? Cell::WALL_RIGHT : 0);
+    }
+
+public:
+
+    // range over the neighbors of one cell, so they can be used in a range-based for loop
+    struct Neighbors {
+        const int* first;
+        const int* last;
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        int size() const { return last - first; }
+    };
+
+    NavGraph() : V(0), rows(0), cols(0) {}
+
+    // create the edges from the walls of the maze
+    // two passes over the cells, one counts the open sides of each cell and one writes the neighbors behind them,
+    // so the edges are allocated once at their final size instead of growing and being copied by shrink_to_fit
+    void build(const Grid &grid) {
+        static const unsigned char sideCount[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+        rows = grid.getRows();
+        cols = grid.getCols();
+        V = rows*cols;
+
+        offsets.resize(V + 1);
+        offsets[0] = 0;
+        for(int i=0;i<rows;i++){
+            const Cell* row = grid[i];
+            int rowMask = (i > 0 ? Cell::WALL_UP : 0) | (i < rows-1 ? Cell::WALL_DOWN : 0);
+            int* count = &offsets[i*cols];
+            for(int j=0;j<cols;j++)
+                count[j+1] = count[j] + sideCount[openSides(row[j], borderMask(rowMask, j))];
+        }
+
+        // every side is written and the end only moves past the open ones, the walls of a random maze are
+        // as good as coin flips and a branch per side would be mispredicted half the time;
+        // the last cell can write up to four slots past the edges, they are cut off again
+        vector<int>().swap(neighbors);
+        neighbors.resize(offsets[V] + 4);
+        int* next = neighbors.data();
+        for(int i=0;i<rows;i++){
+            const Cell* row = grid[i];
+            int rowMask = (i > 0 ? Cell::WALL_UP : 0) | (i < rows-1 ? Cell::WALL_DOWN : 0);
+            for(int j=0;j<cols;j++){
+                int v = j+i*cols, open = openSides(row[j], borderMask(rowMask, j));
+                *next = v-cols;
+                next += open & 1;
+                *next = v+cols;
+                next += (open >> 1) & 1;
+                *next = v-1;
+                next += (open >> 2) & 1;
+                *next = v+1;
+                next += (open >> 3) & 1;
+            }
+        }
+        neighbors.resize(offsets[V]);
+    }
+
+    int getV() const { return V; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    Neighbors neighborsOf(int v) const {
+        Neighbors range;
+        range.first = neighbors.data() + offsets[v];
+        range.last = neighbors.data() + offsets[v+1];
+        return range;
+    }
+
+    int degree(int v) const {
+        return offsets[v+1] - offsets[v];
+    }
+};
+
+#endif // OPENGLPRJ_NAVGRAPH_H
@@ -0,0 +1,114 @@
+#ifndef OPENGLPRJ_NAVTABLE_H
+#define OPENGLPRJ_NAVTABLE_H
+#include <vector>
+#include "NavGraph.h"
+using namespace std;
+
+// all-pairs navigation table for a static maze
+// for every (source, destination) pair it stores the first step of the shortest path and its length,
+// so a ghost only needs a single table read per cell instead of a full BFS
+class NavTable {
+
+private:
+
+    // number of cells, rows and columns of the maze the table was built for
+    int V;
+    int rows;
+    int cols;
+
+    // row-major tables indexed by source*V + dest
+    // the next hop is stored as a direction (see below) and the distance in steps
+    vector<unsigned char> nextHop;
+    vector<unsigned short> distance;
+
+    // directions stored in nextHop, in the same order BFS adds edges
+    enum Direction { UP = 0, DOWN = 1, LEFT = 2, RIGHT = 3, NONE = 255 };
+
+    // run one BFS from source and fill its row of the table
+    // firstHop carries the first step of the path so it can be copied to every cell reached through it
+    void buildRow(const NavGraph &graph, int source, vector<int> &queue, vector<unsigned char> &firstHop) {
+        unsigned char* hopRow = &nextHop[(size_t)source * V];
+        unsigned short* distRow = &distance[(size_t)source * V];
+
+        int head = 0, tail = 0;
+        queue[tail++] = source;
+        distRow[source] = 0;
+        firstHop[source] = NONE;
+
+        while(head < tail) {
+            int temp = queue[head++];
+            for(int k: graph.neighborsOf(temp)) {
+                if(distRow[k] == unreachable) {
+                    distRow[k] = distRow[temp] + 1;
+                    firstHop[k] = temp == source ? direction(source, k) : firstHop[temp];
+                    hopRow[k] = firstHop[k];
+                    queue[tail++] = k;
+                }
+            }
+        }
+    }
+
+    unsigned char direction(int from, int to) const {
+        if(to == from - cols) return UP;
+        if(to == from + cols) return DOWN;
+        if(to == from - 1) return LEFT;
+        return RIGHT;
+    }
+
+public:
+
+    // distance stored for cells that can't reach each other
+    static const unsigned short unreachable = 0xFFFF;
+
+    // the table grows with the square of the number of cells (3 bytes per pair),
+    // so it is only built for mazes up to this size (about 50 MB)
+    static const int maxCells = 4096;
+
+    NavTable() : V(0), rows(0), cols(0) {}
+
+    // build the table from the graph of the maze, returns false if the maze is too big for it
+    bool build(const NavGraph &graph) {
+        rows = graph.getRows();
+        cols = graph.getCols();
+        V = graph.getV();
+
+        if(V == 0 || V > maxCells) {
+            V = 0;
+            nextHop.clear();
+            distance.clear();
+            return false;
+        }
+
+        nextHop.assign((size_t)V * V, NONE);
+        distance.assign((size_t)V * V, (unsigned short)unreachable);
+
+        vector<int> queue(V);
+        vector<unsigned char> firstHop(V);
+        for(int source=0; source<V; source++)
+            buildRow(graph, source, queue, firstHop);
+
+        return true;
+    }
+
+    bool isBuilt() const {
+        return V > 0;
+    }
+
+    // next cell on the shortest path from source to dest, or -1 if dest is the source or unreachable
+    int getNextCell(int source, int dest) const {
+        switch(nextHop[(size_t)source * V + dest]) {
+            case UP: return source - cols;
+            case DOWN: return source + cols;
+            case LEFT: return source - 1;
+            case RIGHT: return source + 1;
+            default: return -1;
+        }
+    }
+
+    // length of the shortest path from source to dest, or unreachable
+    int getDistance(int source, int dest) const {
+        return distance[(size_t)source * V + dest];
+    }
+};
+
+#endif // OPENGLPRJ_NAVTABLE_H
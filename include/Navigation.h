@@ -0,0 +1,211 @@
+#ifndef OPENGLPRJ_NAVIGATION_H
+#define OPENGLPRJ_NAVIGATION_H
+#include <memory>
+#include "NavGraph.h"
+#include "PathFinder.h"
+#include "Bfs.h"
+#include "AStar.h"
+#include "BidirectionalBFS.h"
+#include "BitboardBFS.h"
+#include "HPAStar.h"
+#include "CorridorGraph.h"
+#include "NavTable.h"
+#include "FlowField.h"
+#include "FleeField.h"
+#include "FieldService.h"
+#include "CooperativePlanner.h"
+#include "PathService.h"
+#include "PathCache.h"
+
+// everything the ghosts use to find their way through one maze
+// it is built once per maze in startGame() and shared by all ghosts
+class Navigation {
+private:
+
+    const NavGraph* graph;
+
+    // structure of the maze the graph was built from, nullptr if it wasn't given
+    const MazeTopology* topology;
+
+    // changes every time a maze is built, paths kept by the ghosts are only valid for the version they were found on
+    unsigned int version;
+
+    // engines that aren't used by default are only created the first time a ghost asks for them
+    unique_ptr<AStar> astar;
+    unique_ptr<BidirectionalBFS> bidirectional;
+    unique_ptr<BitboardBFS> bitboard;
+    unique_ptr<CorridorGraph> corridors;
+    unique_ptr<Landmarks> landmarks;
+    unique_ptr<AStar> alt;
+    unique_ptr<CooperativePlanner> planner;
+
+    // the hierarchy takes seconds to build on large mazes, it is only built for ghosts that use ENGINE_HPA
+    unique_ptr<HPAStar> hpa;
+
+    // searches on worker threads, one service per engine, declared last so they stop before the engines they share go away
+    unique_ptr<PathService> services[ENGINE_ALT + 1];
+
+    // flow and flee field to pacman's cell, searched on their own worker thread
+    unique_ptr<FieldService> fields;
+
+public:
+
+    // search for single paths, also used by scared ghosts
+    BFS bfs;
+
+    // next step between every pair of cells, only built for small mazes
+    NavTable table;
+
+    // landmarks used by the ALT engine, each one costs 4 bytes per cell
+    static const int landmarkCount = PathService::landmarkCount;
+
+    // hits and misses of the ghosts' path caches since the game started
+    PathCacheStats pathCacheStats;
+
+    // outcomes of the ghosts' path service requests since the game started
+    PathServiceStats pathServiceStats;
+
+    Navigation() : graph(nullptr), topology(nullptr), version(0) {}
+
+    void build(const NavGraph &graph, const MazeTopology* topology = nullptr) {
+        stopSearches();
+        this->graph = &graph;
+        this->topology = topology;
+        version++;
+        bfs = BFS(graph, topology);
+        table.build(graph);
+        fields.reset(new FieldService(graph));
+        astar.reset();
+        bidirectional.reset();
+        bitboard.reset();
+        corridors.reset();
+        alt.reset();
+        planner.reset();
+        landmarks.reset();
+        hpa.reset();
+    }
+
+    // path search of an engine, the flow field isn't a point to point search so it uses BFS
+    PathFinder& getEngine(PathEngine engine) {
+        switch(engine) {
+            case ENGINE_ASTAR:
+                if(!astar) astar.reset(new AStar(*graph));
+                return *astar;
+            case ENGINE_BIDIRECTIONAL:
+                if(!bidirectional) bidirectional.reset(new BidirectionalBFS(*graph));
+                return *bidirectional;
+            case ENGINE_BITBOARD:
+                if(!bitboard) bitboard.reset(new BitboardBFS(*graph));
+                return *bitboard;
+            case ENGINE_ALT:
+                if(!alt)
+                    alt.reset(new AStar(*graph, &getLandmarks()));
+                return *alt;
+            case ENGINE_CORRIDOR:
+                return getCorridors();
+            case ENGINE_HPA:
+                if(!hpa) hpa.reset(new HPAStar(*graph));
+                return *hpa;
+            default:
+                return bfs;
+        }
+    }
+
+    // pacman's cell, called once per frame before the ghosts move, flee asks for the flee field as well
+    // the fields are searched on their worker, the ghosts read the last ones it finished until the new ones are swapped in
+    void updateTarget(int pacman, bool flee) {
+        fields->request(pacman, flee);
+        fields->poll();
+    }
+
+    // cell the fields were last asked for, they may still be on an earlier one
+    int getFieldTarget() const {
+        return fields->getTarget();
+    }
+
+    const FlowField& getFlowField() const {
+        return fields->getFlowField();
+    }
+
+    FieldService& getFieldService() {
+        return *fields;
+    }
+
+    // next cell of a scared ghost running from pacman, -1 if it is safest where it is
+    // until the first flee field is done the ghost steps to the neighbor furthest from pacman on the flow field
+    int getFleeCell(int source) const {
+        const FleeField* fleeField = fields->getFleeField();
+        if(fleeField != nullptr)
+            return fleeField->getNextCell(source);
+        const FlowField &flowField = fields->getFlowField();
+        int best = -1, bestDistance = flowField.getDistance(source);
+        if(bestDistance == FlowField::unreachable)
+            return -1;
+        for(int k: graph->neighborsOf(source)) {
+            if(flowField.getDistance(k) > bestDistance) {
+                best = k;
+                bestDistance = flowField.getDistance(k);
+            }
+        }
+        return best;
+    }
+
+    // cooperative plans for large groups of ghosts that step together, fed with the flow field
+    CooperativePlanner& getPlanner() {
+        if(!planner) planner.reset(new CooperativePlanner(*graph));
+        return *planner;
+    }
+
+    // searches of an engine that run off the calling thread, the workers are started the first time it is asked for
+    // preprocessing that was already built is shared, the rest is built by the service's first worker
+    PathService& getPathService(PathEngine engine) {
+        if(!services[engine])
+            services[engine].reset(new PathService(*graph, engine, EngineData(landmarks.get(),
+                hpa ? &hpa->getClusters() : nullptr, corridors ? &corridors->getMap() : nullptr)));
+        return *services[engine];
+    }
+
+    // forget a request of an engine's path service, the service isn't started for it if it isn't running
+    void cancelSearch(PathEngine engine, int ticket) {
+        if(services[engine])
+            services[engine]->cancel(ticket);
+    }
+
+    // stop all worker threads, has to be called before the graph they search is changed
+    void stopSearches() {
+        for(unique_ptr<PathService> &service : services)
+            service.reset();
+        fields.reset();
+    }
+
+    // the landmarks are computed on the calling thread the first time, a path service started later shares them
+    const Landmarks& getLandmarks() {
+        if(!landmarks) landmarks.reset(new Landmarks(*graph, landmarkCount));
+        return *landmarks;
+    }
+
+    const MazeTopology* getTopology() const {
+        return topology;
+    }
+
+    // whether a search from source can reach dest, true when the topology isn't known
+    bool canReach(int source, int dest) const {
+        return topology == nullptr || topology->isConnected(source, dest);
+    }
+
+    unsigned int getVersion() const {
+        return version;
+    }
+
+    // true for cells with exactly two passages, read from the graph so the render thread never builds the corridor map
+    bool isCorridor(int cell) const {
+        return graph->degree(cell) == 2;
+    }
+
+    CorridorGraph& getCorridors() {
+        if(!corridors) corridors.reset(new CorridorGraph(*graph));
+        return *corridors;
+    }
+};
+
+#endif // OPENGLPRJ_NAVIGATION_H
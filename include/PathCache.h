@@ -0,0 +1,96 @@
+#ifndef OPENGLPRJ_PATHCACHE_H
+#define OPENGLPRJ_PATHCACHE_H
+#include <vector>
+using namespace std;
+
+// how often the ghosts could keep walking their last path instead of searching again, summed over all ghosts
+struct PathCacheStats {
+    long long hits;
+    long long misses;
+
+    PathCacheStats() : hits(0), misses(0) {}
+
+    double getHitRate() const {
+        return hits + misses == 0 ? 0 : (double)hits / (hits + misses);
+    }
+};
+
+// the last path of one ghost together with the target cell and maze version it was searched for
+// the ghost walks it by moving an index, nothing is erased or copied, and it only needs a new search
+// when pacman has changed cells or the maze was rebuilt
+class PathCache {
+private:
+    vector<int> cells;
+    size_t index;
+    int target;
+    unsigned int version;
+    PathCacheStats* stats;
+
+public:
+    PathCache() : index(0), target(-1), version(0), stats(nullptr) {}
+
+    explicit PathCache(PathCacheStats &stats) : index(0), target(-1), version(0), stats(&stats) {}
+
+    bool empty() const {
+        return index >= cells.size();
+    }
+
+    // the cell to walk to, -1 if the path is used up
+    int next() const {
+        return empty() ? -1 : cells[index];
+    }
+
+    size_t remaining() const {
+        return empty() ? 0 : cells.size() - index;
+    }
+
+    // the next cell was reached
+    void advance() {
+        if(!empty())
+            index++;
+    }
+
+    // true if the rest of the path still leads to target on this version of the maze, counted as a hit or a miss
+    bool lookup(int target, unsigned int version) {
+        bool hit = !empty() && target == this->target && version == this->version;
+        if(stats != nullptr) {
+            if(hit)
+                stats->hits++;
+            else
+                stats->misses++;
+        }
+        return hit;
+    }
+
+    // same as lookup without counting, for callers that only decide whether to search
+    bool leadsTo(int target, unsigned int version) const {
+        return !empty() && target == this->target && version == this->version;
+    }
+
+    // the vector a new path to target is written into, it is walked from its first cell
+    vector<int>& store(int target, unsigned int version) {
+        this->target = target;
+        this->version = version;
+        index = 0;
+        return cells;
+    }
+
+    // take over a path and walk it from position from, the caller gets the old vector back to reuse
+    void swap(vector<int> &path, size_t from, int target, unsigned int version) {
+        cells.swap(path);
+        this->target = target;
+        this->version = version;
+        index = from;
+    }
+
+    // a single step that isn't kept for a target, for ghosts that decide again on every cell
+    void setNext(int cell) {
+        cells.clear();
+        index = 0;
+        target = -1;
+        if(cell != -1)
+            cells.push_back(cell);
+    }
+};
+
+#endif // OPENGLPRJ_PATHCACHE_H
@@ -0,0 +1,36 @@
+#ifndef OPENGLPRJ_PATHFINDER_H
+#define OPENGLPRJ_PATHFINDER_H
+#include <vector>
+using namespace std;
+
+// engines a ghost can use to find its path, chosen when the ghost is created
+enum PathEngine {
+    ENGINE_FLOW_FIELD,      // shared distances to pacman, one search per pacman cell change (default)
+    ENGINE_BFS,
+    ENGINE_ASTAR,
+    ENGINE_BIDIRECTIONAL,
+    ENGINE_BITBOARD,
+    ENGINE_HPA,             // hierarchical search for very large mazes
+    ENGINE_CORRIDOR,        // search on junctions and dead ends only, corridors are walked without searching
+    ENGINE_ALT              // A* with landmark distances as heuristic
+};
+
+// interface of the single pair path searches
+class PathFinder {
+public:
+    virtual ~PathFinder() {}
+
+    // shortest path from source to dest written into path without the source cell
+    // returns false and leaves path empty if dest is the source or can't be reached
+    virtual bool getPath(int source, int dest, vector<int> &path) = 0;
+
+    // the beginning of the same path, at least one cell if there is a path
+    // engines that can stop before building the whole path override it
+    virtual bool getPathStart(int source, int dest, vector<int> &path) {
+        return getPath(source, dest, path);
+    }
+
+    virtual const char* getName() const = 0;
+};
+
+#endif // OPENGLPRJ_PATHFINDER_H
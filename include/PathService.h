@@ -0,0 +1,292 @@
+#ifndef OPENGLPRJ_PATHSERVICE_H
+#define OPENGLPRJ_PATHSERVICE_H
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "NavGraph.h"
+#include "PathFinder.h"
+#include "Bfs.h"
+#include "AStar.h"
+#include "BidirectionalBFS.h"
+#include "BitboardBFS.h"
+#include "HPAStar.h"
+#include "CorridorGraph.h"
+using namespace std;
+
+// read only preprocessing the engines of a service share: landmarks for ENGINE_ALT, the cluster graph for ENGINE_HPA
+// and the corridor map for ENGINE_CORRIDOR, whatever isn't given is built by the service
+// landmarks the service builds itself are used once they are done, until then its ALT searches are plain A*
+struct EngineData {
+    const Landmarks* landmarks;
+    const ClusterGraph* clusters;
+    const CorridorMap* corridors;
+
+    EngineData(const Landmarks* landmarks = nullptr, const ClusterGraph* clusters = nullptr, const CorridorMap* corridors = nullptr)
+        : landmarks(landmarks), clusters(clusters), corridors(corridors) {}
+};
+
+// what became of the searches the ghosts asked the path services for, summed over all ghosts
+// every request ends as exactly one of the outcomes unless it is still waiting
+struct PathServiceStats {
+    long long requests;
+    // results used for the target the ghost still chases
+    long long taken;
+    // results for a target pacman had left by the time they were ready
+    long long stale;
+    // results for the target whose path doesn't pass the ghost's cell anymore, searched again
+    long long missed;
+    // searches dropped before they were done because the target changed
+    long long cancelled;
+    // requests still waiting for a worker when the target changed, moved to the new target instead of asked again
+    long long retargeted;
+    // results overwritten by newer requests before the ghost took them
+    long long lost;
+
+    PathServiceStats() : requests(0), taken(0), stale(0), missed(0), cancelled(0), retargeted(0), lost(0) {}
+
+    long long getFinished() const {
+        return taken + stale + missed + cancelled + lost;
+    }
+};
+
+// path searches on worker threads, so the frame that asks for a path never waits for the search
+// every worker has its own engine because the engines keep their search state between calls,
+// the graph and the preprocessing of the engine are built once and only read by all of them
+// requests are answered in order, a result waits in a ring of slots picked by its ticket until it is taken,
+// results nobody takes are overwritten by later requests instead of piling up
+// all calls are made from one thread (the render loop), only the workers run in parallel to it
+class PathService {
+public:
+
+    enum Status {
+        PENDING,    // still waiting or being searched
+        READY,      // the result was written, the ticket is done
+        LOST        // the slot was reused by a newer request before the result was taken, ask again
+    };
+
+    // a finished search, path is empty if dest can't be reached or is the source
+    struct Result {
+        int source;
+        int dest;
+        vector<int> path;
+    };
+
+private:
+
+    struct Request {
+        int ticket;
+        int source;
+        int dest;
+    };
+
+    struct Slot {
+        int ticket;
+        bool done;
+        Result result;
+    };
+
+    const NavGraph* graph;
+    PathEngine engine;
+    EngineData data;
+
+    // preprocessing the service built itself because it wasn't given, the first worker builds it
+    unique_ptr<Landmarks> ownLandmarks;
+    unique_ptr<ClusterGraph> ownClusters;
+    unique_ptr<CorridorMap> ownCorridors;
+    once_flag prepared;
+
+    // set once the landmarks of an ALT service can be read, the workers don't wait for them
+    atomic<const Landmarks*> readyLandmarks;
+
+    mutex lock;
+    condition_variable wake;
+    deque<Request> requests;
+    vector<Slot> slots;
+    int nextTicket;
+    bool stopping;
+    vector<thread> workers;
+
+    // build the preprocessing of the engine if it wasn't given
+    void prepare() {
+        if(engine == ENGINE_ALT && data.landmarks == nullptr) {
+            ownLandmarks.reset(new Landmarks(*graph, landmarkCount));
+            readyLandmarks.store(ownLandmarks.get(), memory_order_release);
+        }
+        if(engine == ENGINE_HPA && data.clusters == nullptr) {
+            ownClusters.reset(new ClusterGraph(*graph));
+            data.clusters = ownClusters.get();
+        }
+        if(engine == ENGINE_CORRIDOR && data.corridors == nullptr) {
+            ownCorridors.reset(new CorridorMap(*graph));
+            data.corridors = ownCorridors.get();
+        }
+    }
+
+    // own engine of a worker, only its search buffers, the flow field isn't a point to point search so it uses BFS like Navigation
+    PathFinder* createEngine() const {
+        switch(engine) {
+            case ENGINE_ASTAR: return new AStar(*graph);
+            case ENGINE_ALT: return new AStar(*graph, readyLandmarks.load(memory_order_acquire));
+            case ENGINE_BIDIRECTIONAL: return new BidirectionalBFS(*graph);
+            case ENGINE_BITBOARD: return new BitboardBFS(*graph);
+            case ENGINE_HPA: return new HPAStar(*data.clusters);
+            case ENGINE_CORRIDOR: return new CorridorGraph(*data.corridors);
+            default: return new BFS(*graph);
+        }
+    }
+
+    void work(bool first) {
+        // the first worker builds the preprocessing and the others wait for it, not the thread that created the service
+        // the landmarks take a few hundred milliseconds on large mazes, the other workers search without them meanwhile
+        if(engine != ENGINE_ALT || first)
+            call_once(prepared, &PathService::prepare, this);
+        unique_ptr<PathFinder> finder(createEngine());
+        bool hasLandmarks = engine != ENGINE_ALT || readyLandmarks.load(memory_order_acquire) != nullptr;
+        vector<int> path;
+        unique_lock<mutex> guard(lock);
+        while(true) {
+            wake.wait(guard, [this] { return stopping || !requests.empty(); });
+            if(stopping)
+                return;
+            Request request = requests.front();
+            requests.pop_front();
+
+            guard.unlock();
+            if(!hasLandmarks && readyLandmarks.load(memory_order_acquire) != nullptr) {
+                static_cast<AStar*>(finder.get())->setLandmarks(readyLandmarks.load(memory_order_acquire));
+                hasLandmarks = true;
+            }
+            finder->getPath(request.source, request.dest, path);
+            guard.lock();
+
+            Slot &slot = slots[request.ticket % slots.size()];
+            if(slot.ticket == request.ticket) {
+                slot.done = true;
+                slot.result.source = request.source;
+                slot.result.dest = request.dest;
+                slot.result.path.swap(path);
+            }
+        }
+    }
+
+public:
+
+    static const int defaultSlots = 256;
+
+    // landmarks an ALT service builds itself, each one costs 4 bytes per cell
+    static const int landmarkCount = 8;
+
+    // preprocessing that is given is shared read only and has to outlive the service
+    // threads = 0 uses one thread less than the machine has, but at least one
+    // an ALT service that builds its own landmarks has at least two, one keeps searching while the first builds them
+    PathService(const NavGraph &graph, PathEngine engine, EngineData data = EngineData(), int threads = 0, int slotCount = defaultSlots)
+            : graph(&graph), engine(engine), data(data), readyLandmarks(data.landmarks), slots(slotCount), nextTicket(0), stopping(false) {
+        for(Slot &slot : slots) {
+            slot.ticket = -1;
+            slot.done = false;
+        }
+        if(threads <= 0)
+            threads = (int)thread::hardware_concurrency() - 1;
+        if(threads < 1)
+            threads = 1;
+        if(engine == ENGINE_ALT && data.landmarks == nullptr && threads < 2)
+            threads = 2;
+        for(int i = 0; i < threads; i++)
+            workers.push_back(thread(&PathService::work, this, i == 0));
+    }
+
+    PathService(const PathService&) = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    // waiting requests are dropped, searches already running are finished first
+    ~PathService() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+            requests.clear();
+        }
+        wake.notify_all();
+        for(thread &worker : workers)
+            worker.join();
+    }
+
+    // queue a search and return its ticket
+    int request(int source, int dest) {
+        int ticket;
+        {
+            lock_guard<mutex> guard(lock);
+            ticket = nextTicket;
+            nextTicket = (nextTicket + 1) & 0x7fffffff;
+            Slot &slot = slots[ticket % slots.size()];
+            slot.ticket = ticket;
+            slot.done = false;
+            Request r = {ticket, source, dest};
+            requests.push_back(r);
+        }
+        wake.notify_one();
+        return ticket;
+    }
+
+    // take the result of a ticket if it is done, the ticket can't be used after it returns READY or LOST
+    Status poll(int ticket, Result &result) {
+        lock_guard<mutex> guard(lock);
+        Slot &slot = slots[ticket % slots.size()];
+        if(slot.ticket != ticket)
+            return LOST;
+        if(!slot.done)
+            return PENDING;
+        result.source = slot.result.source;
+        result.dest = slot.result.dest;
+        result.path.swap(slot.result.path);
+        slot.ticket = -1;
+        return READY;
+    }
+
+    // move a request no worker has started on to a new source and target, it keeps its place in the queue
+    // returns false if the search already started, the ticket is unchanged then
+    bool retarget(int ticket, int source, int dest) {
+        lock_guard<mutex> guard(lock);
+        for(Request &request : requests) {
+            if(request.ticket == ticket) {
+                request.source = source;
+                request.dest = dest;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // forget a ticket whose result isn't wanted anymore, it isn't searched if no worker has started on it
+    void cancel(int ticket) {
+        lock_guard<mutex> guard(lock);
+        for(size_t i = 0; i < requests.size(); i++) {
+            if(requests[i].ticket == ticket) {
+                requests.erase(requests.begin() + i);
+                break;
+            }
+        }
+        Slot &slot = slots[ticket % slots.size()];
+        if(slot.ticket == ticket)
+            slot.ticket = -1;
+    }
+
+    // requests that no worker has started on yet
+    int getQueued() {
+        lock_guard<mutex> guard(lock);
+        return requests.size();
+    }
+
+    int getThreads() const {
+        return workers.size();
+    }
+
+    PathEngine getEngine() const {
+        return engine;
+    }
+};
+
+#endif // OPENGLPRJ_PATHSERVICE_H
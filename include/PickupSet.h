@@ -0,0 +1,136 @@
+#ifndef OPENGLPRJ_PICKUPSET_H
+#define OPENGLPRJ_PICKUPSET_H
+#include <vector>
+#include <cstdint>
+#include "Grid.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace std;
+
+// the cells that still hold a coin, or a powerup, as one bit per cell
+// every row starts at a new word, so the cells of a row range are a few words that are walked with
+// count-trailing-zeros, only touching the cells that are set; a late game board with few pickups left costs almost nothing
+// the number left is kept up to date on every change and counted again with popcount when the set is filled
+class PickupSet {
+private:
+    int rows;
+    int cols;
+
+    // words per row
+    int stride;
+
+    vector<uint64_t> words;
+    size_t remaining;
+
+    static int countTrailingZeros(uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return (int)index;
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    static int popCount(uint64_t word) {
+#ifdef _MSC_VER
+        return (int)__popcnt64(word);
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+
+public:
+    PickupSet() : rows(0), cols(0), stride(0), remaining(0) {}
+
+    // empty set for a maze of this size
+    void resize(int rows, int cols) {
+        this->rows = rows;
+        this->cols = cols;
+        stride = (cols + 63) / 64;
+        words.assign((size_t)rows * stride, 0);
+        remaining = 0;
+    }
+
+    // the coins (or the powerups) of a grid
+    void fill(const Grid &grid, bool powerups) {
+        resize(grid.getRows(), grid.getCols());
+        for(int i=0; i<rows; i++) {
+            const Cell *row = grid[i];
+            uint64_t *rowWords = &words[(size_t)i * stride];
+            for(int j=0; j<cols; j++)
+                if(powerups ? row[j].hasPowerup() : row[j].hasCoin())
+                    rowWords[j >> 6] |= (uint64_t)1 << (j & 63);
+        }
+        recount();
+    }
+
+    bool has(int row, int col) const {
+        return (words[(size_t)row * stride + (col >> 6)] >> (col & 63)) & 1;
+    }
+
+    void set(int row, int col) {
+        uint64_t &word = words[(size_t)row * stride + (col >> 6)];
+        uint64_t mask = (uint64_t)1 << (col & 63);
+        if(!(word & mask)) {
+            word |= mask;
+            remaining++;
+        }
+    }
+
+    // remove the pickup of a cell, returns false if there was none
+    bool take(int row, int col) {
+        uint64_t &word = words[(size_t)row * stride + (col >> 6)];
+        uint64_t mask = (uint64_t)1 << (col & 63);
+        if(!(word & mask))
+            return false;
+        word &= ~mask;
+        remaining--;
+        return true;
+    }
+
+    size_t count() const {
+        return remaining;
+    }
+
+    bool empty() const {
+        return remaining == 0;
+    }
+
+    // count the set bits of all words
+    size_t recount() {
+        remaining = 0;
+        for(uint64_t word : words)
+            remaining += popCount(word);
+        return remaining;
+    }
+
+    // call f(row, col) for every cell in [rowFrom, rowTo) x [colFrom, colTo) that is set, row by row
+    template <class F>
+    void forEach(int rowFrom, int rowTo, int colFrom, int colTo, F f) const {
+        if(colFrom >= colTo)
+            return;
+        int firstWord = colFrom >> 6, lastWord = (colTo - 1) >> 6;
+        uint64_t firstMask = ~(uint64_t)0 << (colFrom & 63);
+        uint64_t lastMask = ~(uint64_t)0 >> (63 - ((colTo - 1) & 63));
+        for(int i=rowFrom; i<rowTo; i++) {
+            const uint64_t *rowWords = &words[(size_t)i * stride];
+            for(int w=firstWord; w<=lastWord; w++) {
+                uint64_t word = rowWords[w];
+                if(w == firstWord) word &= firstMask;
+                if(w == lastWord) word &= lastMask;
+                while(word != 0) {
+                    f(i, (w << 6) + countTrailingZeros(word));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    size_t getMemoryBytes() const {
+        return words.capacity() * sizeof(uint64_t);
+    }
+};
+
+#endif // OPENGLPRJ_PICKUPSET_H
@@ -0,0 +1,141 @@
+#ifndef OPENGLPRJ_PRIMGENERATOR_H
+#define OPENGLPRJ_PRIMGENERATOR_H
+#include <vector>
+#include "Generator.h"
+using namespace std;
+
+// randomized Prim's: the maze grows from a random cell by picking a random unvisited cell next to it,
+// which connects to one visited neighbor or, most of the time, to two, so the maze gets loops
+class PrimGenerator : public Generator {
+private:
+    Grid *grid;
+    int rows;
+    int cols;
+
+    // unvisited cells next to the visited part, and a flag per cell that tells if it is in the list
+    vector<pair<int, int>> frontier;
+    vector<bool> inFrontier;
+
+    size_t peakBytes;
+
+    bool isNotVisited(int row, int col) {
+        return (row >= 0 && row < rows && col >= 0 && col < cols && !(*grid)[row][col].isVisited());
+    }
+
+    bool isVisited(int row, int col) {
+        return (row >= 0 && row < rows && col >= 0 && col < cols && (*grid)[row][col].isVisited());
+    }
+
+    // add a cell to the frontier if it isn't visited and not in the frontier yet, O(1) with the in-frontier flags
+    void addToFrontier(int row, int col) {
+        if (isNotVisited(row, col) && !inFrontier[col + row*cols]) {
+            inFrontier[col + row*cols] = true;
+            frontier.push_back(make_pair(row, col));
+        }
+    }
+
+    void addNeighbor(int currentRow, int currentCol, int neighborRow, int neighborCol) {
+        openWall(*grid, currentCol + currentRow*cols, neighborCol + neighborRow*cols);
+    }
+
+public:
+    PrimGenerator() : grid(nullptr), rows(0), cols(0), peakBytes(0) {}
+
+    void carve(Grid &target, Random &random) override {
+        grid = &target;
+        rows = target.getRows();
+        cols = target.getCols();
+        peakBytes = 0;
+
+        // generate random column and row
+        int startRow = random.below(rows);
+        int startCol = random.below(cols);
+
+        // mark cell as visited
+        target[startRow][startCol].setVisited(true);
+        frontier.clear();
+        inFrontier.assign((size_t)rows * cols, false);
+
+        // add unvisited neighbors to list
+        addToFrontier(startRow - 1, startCol);
+        addToFrontier(startRow + 1, startCol);
+        addToFrontier(startRow, startCol - 1);
+        addToFrontier(startRow, startCol + 1);
+
+        // current cells neighbors, reused for every cell
+        vector<pair<int, int>> neighbors;
+        neighbors.reserve(4);
+
+        // loop while unvisited cells list is full
+        while (!frontier.empty()) {
+            // choose a cell
+            int randomIndex = random.below(frontier.size());
+            int currentRow = frontier[randomIndex].first;
+            int currentCol = frontier[randomIndex].second;
+            target[currentRow][currentCol].setVisited(true);
+
+            // add all visited neighboring cells
+            neighbors.clear();
+            if (isVisited(currentRow - 1, currentCol)) neighbors.push_back(make_pair(currentRow - 1, currentCol));
+            if (isVisited(currentRow + 1, currentCol)) neighbors.push_back(make_pair(currentRow + 1, currentCol));
+            if (isVisited(currentRow, currentCol - 1)) neighbors.push_back(make_pair(currentRow, currentCol - 1));
+            if (isVisited(currentRow, currentCol + 1)) neighbors.push_back(make_pair(currentRow, currentCol + 1));
+
+            // pick a random neighbor to connect to
+            if (!neighbors.empty()) {
+                // randomly connect to 2 neighbors
+                int chance = random.below(100);
+                if(chance >= 30){
+                    if(neighbors.size() > 1){
+                        for(int i=0;i<2;i++){
+                            int randomNeighborIndex = random.below(neighbors.size());
+                            int neighborRow = neighbors[randomNeighborIndex].first;
+                            int neighborCol = neighbors[randomNeighborIndex].second;
+
+                            addNeighbor(currentRow, currentCol, neighborRow, neighborCol);
+                            neighbors.erase(neighbors.begin() + randomNeighborIndex);
+                        }
+                    }else{
+                        int randomNeighborIndex = random.below(neighbors.size());
+                        int neighborRow = neighbors[randomNeighborIndex].first;
+                        int neighborCol = neighbors[randomNeighborIndex].second;
+
+                        addNeighbor(currentRow, currentCol, neighborRow, neighborCol);
+                    }
+                }else{
+                    int randomNeighborIndex = random.below(neighbors.size());
+                    int neighborRow = neighbors[randomNeighborIndex].first;
+                    int neighborCol = neighbors[randomNeighborIndex].second;
+
+                    addNeighbor(currentRow, currentCol, neighborRow, neighborCol);
+                }
+            }
+            // remove current cell from list by moving the last cell into its place,
+            // the order of the list doesn't matter because cells are picked at random
+            frontier[randomIndex] = frontier.back();
+            frontier.pop_back();
+
+            // add all new unvisited neighbors
+            addToFrontier(currentRow - 1, currentCol);
+            addToFrontier(currentRow + 1, currentCol);
+            addToFrontier(currentRow, currentCol - 1);
+            addToFrontier(currentRow, currentCol + 1);
+        }
+
+        // the flags are only needed while generating
+        peakBytes = frontier.capacity() * sizeof(pair<int, int>) + inFrontier.capacity() / 8;
+        vector<bool>().swap(inFrontier);
+        vector<pair<int, int>>().swap(frontier);
+        grid = nullptr;
+    }
+
+    size_t getPeakMemoryBytes() const override {
+        return peakBytes;
+    }
+
+    const char* getName() const override {
+        return "prim";
+    }
+};
+
+#endif // OPENGLPRJ_PRIMGENERATOR_H
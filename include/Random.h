@@ -0,0 +1,57 @@
+#ifndef OPENGLPRJ_RANDOM_H
+#define OPENGLPRJ_RANDOM_H
+#include <cstdint>
+#include <chrono>
+#include <random>
+
+// small fast random number generator (PCG32: a 64 bit linear congruential state with a permuted 32 bit output)
+// every maze has its own, so a maze can be made again from its seed and several mazes can be made at once on threads,
+// which rand() with its hidden shared state can't do
+class Random {
+private:
+    uint64_t state;
+    uint64_t increment;
+    uint64_t seed;
+
+public:
+    explicit Random(uint64_t seed = 0, uint64_t stream = 54) : state(0), increment((stream << 1) | 1), seed(seed) {
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ull + increment;
+        uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = (uint32_t)(old >> 59);
+        return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+    }
+
+    // uniform number in [0, bound), multiply and shift with a rejection step so no number is more likely than another
+    uint32_t below(uint32_t bound) {
+        uint64_t product = (uint64_t)next() * bound;
+        uint32_t low = (uint32_t)product;
+        if(low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while(low < threshold) {
+                product = (uint64_t)next() * bound;
+                low = (uint32_t)product;
+            }
+        }
+        return (uint32_t)(product >> 32);
+    }
+
+    uint64_t getSeed() const {
+        return seed;
+    }
+
+    // a seed that differs from run to run, for mazes that don't need to be made again
+    static uint64_t randomSeed() {
+        random_device device;
+        uint64_t high = device();
+        return ((high << 32) | device()) ^ (uint64_t)chrono::steady_clock::now().time_since_epoch().count();
+    }
+};
+
+#endif // OPENGLPRJ_RANDOM_H
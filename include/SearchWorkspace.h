@@ -0,0 +1,90 @@
+#ifndef OPENGLPRJ_SEARCHWORKSPACE_H
+#define OPENGLPRJ_SEARCHWORKSPACE_H
+#include <vector>
+using namespace std;
+
+// memory reused by every search on the same graph
+// visited marks are stamped with the generation of the search, so starting a new search doesn't clear anything,
+// and the queue is a fixed ring buffer because every cell is pushed at most once per search
+class SearchWorkspace {
+
+private:
+
+    int V;
+    unsigned int generation;
+    vector<unsigned int> visitedStamp;
+    vector<int> parent;
+
+    // cells marked for the current search, e.g. the cells a search has to reach before it can stop
+    vector<unsigned int> markStamp;
+
+    // ring queue
+    vector<int> ring;
+    int head, tail, count;
+
+public:
+
+    SearchWorkspace() : V(0), generation(0), head(0), tail(0), count(0) {}
+
+    // allocate the arrays for a graph with V cells, only done once per graph
+    explicit SearchWorkspace(int V) : V(V), generation(0), visitedStamp(V, 0), parent(V, -1), markStamp(V, 0), ring(V), head(0), tail(0), count(0) {}
+
+    int size() const {
+        return V;
+    }
+
+    // forget the previous search in O(1)
+    void newSearch() {
+        generation++;
+        // after the counter wraps around old stamps could match again, so clear them once
+        if(generation == 0) {
+            visitedStamp.assign(V, 0);
+            markStamp.assign(V, 0);
+            generation = 1;
+        }
+        head = tail = count = 0;
+    }
+
+    bool isVisited(int v) const {
+        return visitedStamp[v] == generation;
+    }
+
+    // mark cell as visited in this search and remember where it was reached from
+    void visit(int v, int from) {
+        visitedStamp[v] = generation;
+        parent[v] = from;
+    }
+
+    // marks only last until the next search
+    void mark(int v) {
+        markStamp[v] = generation;
+    }
+
+    bool isMarked(int v) const {
+        return markStamp[v] == generation;
+    }
+
+    // only valid for cells visited in the current search
+    int getParent(int v) const {
+        return parent[v];
+    }
+
+    void push(int v) {
+        ring[tail] = v;
+        if(++tail == V) tail = 0;
+        count++;
+    }
+
+    int pop() {
+        int v = ring[head];
+        if(++head == V) head = 0;
+        count--;
+        return v;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+};
+
+#endif // OPENGLPRJ_SEARCHWORKSPACE_H
@@ -0,0 +1,144 @@
+#ifndef OPENGLPRJ_TILEDGENERATOR_H
+#define OPENGLPRJ_TILEDGENERATOR_H
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include "Grid.h"
+#include "Random.h"
+#include "EllerGenerator.h"
+using namespace std;
+
+// maze generation on several threads: the grid is cut into square tiles and every tile gets a maze of its own
+// from Eller's algorithm, then the tiles are stitched by opening one wall between tiles that a union-find over the tiles
+// still sees as apart, so the tiles form a spanning tree and the whole maze is perfect like each tile
+// every tile draws from its own stream of the seed, so the maze only depends on the seed and the tile size,
+// not on the number of threads or on which thread made which tile
+class TiledGenerator : public Generator {
+private:
+    int tileSize;
+    int threads;
+
+    // percent for extra loops, inside the tiles and between them, 0 makes a perfect maze
+    int loopChance;
+
+    // union-find over the tiles, used by the stitching pass
+    vector<int> parent;
+
+    size_t peakBytes;
+
+    int find(int tile) {
+        while(parent[tile] != tile) {
+            parent[tile] = parent[parent[tile]];
+            tile = parent[tile];
+        }
+        return tile;
+    }
+
+    // a wall between two neighboring tiles, the first tile is above or left of the second
+    struct Border {
+        int first;
+        int second;
+        bool vertical;
+    };
+
+    // carve the maze inside one tile, the walls on its border stay closed
+    static void carveTile(Grid &grid, int top, int left, int height, int width, Random random, int loopChance) {
+        EllerGenerator eller(width, random, loopChance);
+        for(int i=0; i<height; i++)
+            eller.nextRow(grid[top + i] + left, i == height - 1);
+    }
+
+public:
+    // threads = 0 uses all the cores of the machine
+    explicit TiledGenerator(int tileSize = 256, int threads = 0, int loopChance = 0)
+        : tileSize(tileSize), threads(threads), loopChance(loopChance), peakBytes(0) {
+        if(this->threads <= 0)
+            this->threads = (int)thread::hardware_concurrency();
+        if(this->threads < 1)
+            this->threads = 1;
+    }
+
+    int getThreads() const { return threads; }
+    int getTileSize() const { return tileSize; }
+
+    // the maze comes from the seed of the random number generator, the generator's own numbers aren't used
+    void carve(Grid &grid, Random &random) override {
+        generate(grid, random.getSeed());
+    }
+
+    size_t getPeakMemoryBytes() const override {
+        return peakBytes;
+    }
+
+    const char* getName() const override {
+        return "tiled";
+    }
+
+    // carve the passages of a grid whose cells all start with closed walls
+    void generate(Grid &grid, uint64_t seed) {
+        int rows = grid.getRows(), cols = grid.getCols();
+        int tileRows = (rows + tileSize - 1) / tileSize;
+        int tileCols = (cols + tileSize - 1) / tileSize;
+        int tiles = tileRows * tileCols;
+
+        // the tiles are handed out one at a time, so a thread that gets small tiles at the edge takes more
+        atomic<int> nextTile(0);
+        auto work = [&]() {
+            for(int tile = nextTile++; tile < tiles; tile = nextTile++) {
+                int top = tile / tileCols * tileSize, left = tile % tileCols * tileSize;
+                int height = min(tileSize, rows - top), width = min(tileSize, cols - left);
+                carveTile(grid, top, left, height, width, Random(seed, tile), loopChance);
+            }
+        };
+        vector<thread> workers;
+        for(int t=1; t<threads && t<tiles; t++)
+            workers.push_back(thread(work));
+        work();
+        for(thread &worker : workers)
+            worker.join();
+
+        // stitching: the borders in random order, the first border between two parts of the maze joins them
+        // the stream after the tiles' streams is used, so it differs from all of them
+        Random random(seed, tiles);
+        vector<Border> borders;
+        borders.reserve(2 * tiles);
+        for(int tile=0; tile<tiles; tile++) {
+            if(tile / tileCols + 1 < tileRows)
+                borders.push_back(Border{tile, tile + tileCols, true});
+            if(tile % tileCols + 1 < tileCols)
+                borders.push_back(Border{tile, tile + 1, false});
+        }
+        for(int k=(int)borders.size()-1; k>0; k--)
+            swap(borders[k], borders[random.below(k + 1)]);
+
+        parent.resize(tiles);
+        for(int tile=0; tile<tiles; tile++)
+            parent[tile] = tile;
+        for(const Border &border : borders) {
+            int a = find(border.first), b = find(border.second);
+            bool open = a != b || (int)random.below(100) < loopChance;
+            if(!open)
+                continue;
+            parent[b] = a;
+
+            // a random cell along the border
+            int top = border.second / tileCols * tileSize, left = border.second % tileCols * tileSize;
+            if(border.vertical) {
+                int col = left + random.below(min(tileSize, cols - left));
+                grid[top - 1][col].setWallDown(false);
+                grid[top][col].setWallUp(false);
+            } else {
+                int row = top + random.below(min(tileSize, rows - top));
+                grid[row][left - 1].setWallRight(false);
+                grid[row][left].setWallLeft(false);
+            }
+        }
+
+        // one tile's row state on every thread, and the stitching
+        peakBytes = min(threads, tiles) * EllerGenerator(min(tileSize, cols), random).getMemoryBytes()
+            + borders.capacity() * sizeof(Border) + parent.capacity() * sizeof(int);
+    }
+};
+
+#endif // OPENGLPRJ_TILEDGENERATOR_H
@@ -0,0 +1,68 @@
+#ifndef OPENGLPRJ_WILSONGENERATOR_H
+#define OPENGLPRJ_WILSONGENERATOR_H
+#include <vector>
+#include "Generator.h"
+using namespace std;
+
+// Wilson's algorithm: from every cell not in the maze yet a random walk runs until it hits the maze,
+// then the walk with its loops erased is added; all perfect mazes of the grid come out equally likely
+// the loops are erased without storing the walk: each cell remembers the direction it was last left in,
+// and following those directions from the start of the walk gives the loop-erased path
+// the cells in the maze are the visited cells of the grid
+class WilsonGenerator : public Generator {
+private:
+    // direction the walk last left each cell in: 0 up, 1 down, 2 left, 3 right
+    vector<unsigned char> exits;
+
+    size_t peakBytes;
+
+public:
+    WilsonGenerator() : peakBytes(0) {}
+
+    void carve(Grid &grid, Random &random) override {
+        int rows = grid.getRows(), cols = grid.getCols();
+        int V = rows * cols;
+        const int step[4] = {-cols, cols, -1, 1};
+        exits.assign(V, 0);
+
+        grid.at(random.below(V)).setVisited(true);
+        for(int start=0; start<V; start++) {
+            if(grid.at(start).isVisited())
+                continue;
+
+            // walk until the maze is hit, only the last exit of every cell is kept
+            int v = start;
+            while(!grid.at(v).isVisited()) {
+                int r = v / cols, c = v % cols;
+                int d;
+                do {
+                    d = random.below(4);
+                } while((d == 0 && r == 0) || (d == 1 && r == rows - 1) || (d == 2 && c == 0) || (d == 3 && c == cols - 1));
+                exits[v] = d;
+                v += step[d];
+            }
+
+            // add the loop-erased walk to the maze
+            v = start;
+            while(!grid.at(v).isVisited()) {
+                grid.at(v).setVisited(true);
+                int next = v + step[exits[v]];
+                openWall(grid, v, next);
+                v = next;
+            }
+        }
+
+        peakBytes = exits.capacity() * sizeof(unsigned char);
+        vector<unsigned char>().swap(exits);
+    }
+
+    size_t getPeakMemoryBytes() const override {
+        return peakBytes;
+    }
+
+    const char* getName() const override {
+        return "wilson";
+    }
+};
+
+#endif // OPENGLPRJ_WILSONGENERATOR_H
@@ -3,6 +3,7 @@
 #include <GLFW/glfw3.h>
 #include "Maze.h"
 #include "Ghost.h"
+#include "Navigation.h"
 #include <iostream>
 #include <cmath>
 #include <vector>
@@ -15,6 +16,8 @@
 #include <AL/alc.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <climits>
 #include FT_FREETYPE_H
 
 const std::string program_name = ("3D PACMAN");
@@ -28,6 +31,7 @@ void loadGhost(Ghost &ghost, Model &ghostModel, Model &scaredModel, Shader &shad
 void loadGhosts(Ghost &blinkyGhost, Ghost &pinkyGhost, Ghost &inkyGhost, Ghost &clydeGhost, Model &blinkyModel, Model &pinkyModel, Model &inkyModel, Model &clydeModel, Model &scaredModel, Shader &shader);
 void loadWalls(glm::mat4 &model, Shader &shader, Model &wall);
 void loadCoinsAndPowerups(glm::mat4 &model, Shader &shader, Model &coin, Model &powerup);
+void getDrawRange(int &rowFrom, int &rowTo, int &colFrom, int &colTo);
 void checkGhostCollision(Ghost &ghost, const glm::vec3 &resetPosition);
 void ghostCollision(Ghost &blinkyGhost, Ghost &pinkyGhost, Ghost &inkyGhost, Ghost &clydeGhost);
 void pickupsCollision(ALuint coinSound, ALuint powerupSound);
@@ -37,6 +41,9 @@ void renderText(Shader shaderProgram,std::string text, std::string text_position
 ALboolean loadWavFile(const char *path, ALenum *format, ALvoid **data, ALsizei *size, ALsizei *frequency);
 ALuint loadSound(const char* filePath, ALboolean loop);
 void startGame();
+vector<int> cornerCells();
+bool printMazeStats(int count);
+glm::vec3 spawnPosition(int ghost);
 
 // screen resolution settings
 const unsigned int SCR_WIDTH = 985;
@@ -52,6 +59,12 @@ glm::mat4 view = glm::mat4(1.0f);
 // game classes
 Ghost blinkyGhost, pinkyGhost, inkyGhost, clydeGhost; // red, pink, blue, orange ghost
 Maze mazeClass;
+Grid &maze = mazeClass.grid; // cells of the current maze, its walls are drawn and collided with
+uint64_t mazeSeed = Random::randomSeed(); // seed of the next maze
+MazeGenerator mazeGenerator = GENERATOR_PRIM;
+const char* levelPath = nullptr; // level file played instead of generated mazes
+vector<int> ghostSpawns; // cells the four ghosts start from and go back to when they are eaten
+Navigation navigation; // searches shared by all ghosts, rebuilt for each maze
 
 static bool GAMEOVER = false;
 bool gameOverSoundPlayed = false;
@@ -59,6 +72,12 @@ int points = 0;
 float timer = 0;
 float wallSize = 0.3f;
 
+// cells further from the camera than the far plane of the projection aren't drawn
+const int drawDistance = 100;
+
+// the lighting shader has lightSide*lightSide point lights (NR_POINT_LIGHTS), they light the coins around pacman
+const int lightSide = 10;
+
 float deltaTime = 0.0f;	// time between current frame and last frame
 float lastFrame = 0.0f; // time of last frame
 
@@ -72,8 +91,60 @@ std::map<GLchar, Character> Characters; // used for text rendering
 
 unsigned int VBO, VAO;
 
-int main()
+int main(int argc, char* argv[])
 {
+    // a level file can be played instead of generated mazes: OpenGLPrj --level file
+    // or a maze can be written to one without starting the game: OpenGLPrj --save-level file [rows cols [seed [generator]]]
+    // or the topology of count mazes from consecutive seeds printed: OpenGLPrj --stats count [rows cols [seed [generator]]]
+    const char* saveLevelPath = nullptr;
+    int statsCount = 0;
+    int first = 1;
+    if (argc >= 3 && strcmp(argv[1], "--level") == 0) {
+        levelPath = argv[2];
+        first = 3;
+    } else if (argc >= 3 && strcmp(argv[1], "--save-level") == 0) {
+        saveLevelPath = argv[2];
+        first = 3;
+    } else if (argc >= 2 && strcmp(argv[1], "--stats") == 0) {
+        char* end = nullptr;
+        long count = argc >= 3 ? strtol(argv[2], &end, 10) : 0;
+        if (argc < 3 || end == argv[2] || *end != '\0' || count <= 0 || count > INT_MAX) {
+            std::cout << "usage: " << argv[0] << " --stats count [rows cols [seed [generator]]], count is a number above 0"
+                      << std::endl;
+            return 1;
+        }
+        statsCount = (int)count;
+        first = 3;
+    }
+
+    // the maze size, the seed of the first maze and the generator can be given on the command line:
+    // OpenGLPrj [rows cols [seed [prim|eller|tiled|kruskal|wilson|backtracker]]]
+    if (argc >= first + 2 && !setMazeSize(atoi(argv[first]), atoi(argv[first + 1]))) {
+        std::cout << "ERROR::MAZE: A maze can't be larger than " << Grid::maxSide << "x" << Grid::maxSide << std::endl;
+        return 1;
+    }
+    if (argc >= first + 3)
+        mazeSeed = strtoull(argv[first + 2], nullptr, 10);
+    for (int g = GENERATOR_PRIM; argc >= first + 4 && g <= GENERATOR_BACKTRACKER; g++) {
+        unique_ptr<Generator> generator(Maze::createGenerator((MazeGenerator)g));
+        if (strcmp(argv[first + 3], generator->getName()) == 0)
+            mazeGenerator = (MazeGenerator)g;
+    }
+
+    if (saveLevelPath != nullptr) {
+        Maze level(rows, cols, mazeSeed, mazeGenerator);
+        level.generateMaze();
+        if (!level.saveLevel(saveLevelPath, cornerCells())) {
+            std::cout << "ERROR::LEVEL: Failed to write " << saveLevelPath << std::endl;
+            return 1;
+        }
+        std::cout << "level saved, maze seed: " << mazeSeed << std::endl;
+        return 0;
+    }
+
+    if (statsCount > 0)
+        return printMazeStats(statsCount) ? 0 : 1;
+
     // glfw: initialize and configure
     // ------------------------------
     glfwInit();
@@ -303,9 +374,12 @@ int main()
 
         // camera for minimap
         glm::vec3 mCameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
-        glm::vec3 mCameraPos = glm::vec3(5.0f, 13.0f, 5.0f);
+        // it shows the 10x10 cells around pacman, the whole maze if it is the default size
+        float mCameraX = glm::clamp(cameraPos.x, 5.0f, std::max(5.0f, cols - 5.0f));
+        float mCameraZ = glm::clamp(cameraPos.z, 5.0f, std::max(5.0f, rows - 5.0f));
+        glm::vec3 mCameraPos = glm::vec3(mCameraX, 13.0f, mCameraZ);
         if(SCR_WIDTH < SCR_HEIGHT)
-            mCameraPos = glm::vec3(5.0f, 16.0f, 5.0f); // a little more zoomed out if portrait
+            mCameraPos = glm::vec3(mCameraX, 16.0f, mCameraZ); // a little more zoomed out if portrait
 
         // view and projection for minimap
         glm::mat4 view2 = glm::lookAt(mCameraPos, mCameraFront + mCameraPos, cameraUp);
@@ -313,8 +387,10 @@ int main()
         projection2 = glm::rotate(projection2, glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
 
         // load floor for minimap
+        // the floor model is 10x10, it is stretched to the size of the maze
+        glm::mat4 floorModel = glm::scale(glm::mat4(1.0f), glm::vec3(cols / 10.0f, 1.0f, rows / 10.0f));
         lightingModelShader.use();
-        lightingModelShader.setMat4("model", model);
+        lightingModelShader.setMat4("model", floorModel);
         lightingModelShader.setMat4("view", view2);
         lightingModelShader.setMat4("projection", projection2);
         floor.Draw(lightingModelShader);
@@ -351,26 +427,31 @@ int main()
 
         // lighting
         lightingModelShader.use();
-        lightingModelShader.setMat4("model", model);
+        lightingModelShader.setMat4("model", floorModel);
         lightingModelShader.setMat4("view", view);
         lightingModelShader.setMat4("projection", projection);
         lightingModelShader.setVec3("viewPos", cameraPos);
         lightingModelShader.setFloat("material.shininess", 32.0f);
 
-        for(int i=0; i < rows; i++){
-            for(int j=0;j< cols;j++){
-                if(maze[i][j].hasCoin){
-                    lightingModelShader.setVec3("pointLights["+std::to_string(i*10+j)+"].position", glm::vec3( j + 0.5f, 0.15f, i + 0.5f));
-                    lightingModelShader.setVec3("pointLights["+std::to_string(i*10+j)+"].diffuse", 30.0f, 30.0f, 30.0f);
-                    lightingModelShader.setFloat("pointLights["+std::to_string(i*10+j)+"].constant", 1.0f);
-                    lightingModelShader.setFloat("pointLights["+std::to_string(i*10+j)+"].linear", 100.0f);
-                    lightingModelShader.setFloat("pointLights["+std::to_string(i*10+j)+"].quadratic", 500.0f);
+        // the lights cover the lightSide x lightSide cells around pacman, the whole maze if it is the default size
+        int lightRow = glm::clamp((int)cameraPos.z - lightSide / 2, 0, std::max(0, rows - lightSide));
+        int lightCol = glm::clamp((int)cameraPos.x - lightSide / 2, 0, std::max(0, cols - lightSide));
+        for(int a=0; a < lightSide; a++){
+            for(int b=0; b < lightSide; b++){
+                int i = lightRow + a, j = lightCol + b;
+                std::string light = "pointLights["+std::to_string(a*lightSide+b)+"]";
+                if(i < rows && j < cols && mazeClass.coins.has(i, j)){
+                    lightingModelShader.setVec3(light+".position", glm::vec3( j + 0.5f, 0.15f, i + 0.5f));
+                    lightingModelShader.setVec3(light+".diffuse", 30.0f, 30.0f, 30.0f);
+                    lightingModelShader.setFloat(light+".constant", 1.0f);
+                    lightingModelShader.setFloat(light+".linear", 100.0f);
+                    lightingModelShader.setFloat(light+".quadratic", 500.0f);
                 }else{
-                    lightingModelShader.setVec3("pointLights["+std::to_string(i*10+j)+"].position", glm::vec3( j + 0.5f, 0.15f, i + 0.5f));
-                    lightingModelShader.setVec3("pointLights["+std::to_string(i*10+j)+"].diffuse", 0.0f, 0.0f, 0.0f);
-                    lightingModelShader.setFloat("pointLights["+std::to_string(i*10+j)+"].constant", 1.0f);
-                    lightingModelShader.setFloat("pointLights["+std::to_string(i*10+j)+"].linear", 0.0f);
-                    lightingModelShader.setFloat("pointLights["+std::to_string(i*10+j)+"].quadratic", 0.0f);
+                    lightingModelShader.setVec3(light+".position", glm::vec3( j + 0.5f, 0.15f, i + 0.5f));
+                    lightingModelShader.setVec3(light+".diffuse", 0.0f, 0.0f, 0.0f);
+                    lightingModelShader.setFloat(light+".constant", 1.0f);
+                    lightingModelShader.setFloat(light+".linear", 0.0f);
+                    lightingModelShader.setFloat(light+".quadratic", 0.0f);
                 }
             }
         }
@@ -398,10 +479,14 @@ int main()
         modelShader.setMat4("view", view);
         modelShader.setMat4("projection", projection);
         if(!GAMEOVER){
-            blinkyGhost.move(deltaTime, std::floor(cameraPos.x) + std::floor(cameraPos.z) * cols);
-            pinkyGhost.move(deltaTime, std::floor(cameraPos.x) + std::floor(cameraPos.z) * cols);
-            inkyGhost.move(deltaTime, std::floor(cameraPos.x) + std::floor(cameraPos.z) * cols);
-            clydeGhost.move(deltaTime, std::floor(cameraPos.x) + std::floor(cameraPos.z) * cols);
+            // one search from pacman's cell, only when it changes, is shared by all ghosts and runs on its own thread
+            int pacmanCell = (int)std::floor(cameraPos.x) + (int)std::floor(cameraPos.z) * cols;
+            navigation.updateTarget(pacmanCell, timer > 0);
+
+            blinkyGhost.move(deltaTime, pacmanCell);
+            pinkyGhost.move(deltaTime, pacmanCell);
+            inkyGhost.move(deltaTime, pacmanCell);
+            clydeGhost.move(deltaTime, pacmanCell);
         }
         loadGhosts(blinkyGhost, pinkyGhost, inkyGhost, clydeGhost, blinky, pinky, inky, clyde, scaredGhost, modelShader);
 
@@ -416,7 +501,7 @@ int main()
         if(!GAMEOVER){
             renderText(textShader, "Points: "+ to_string(points), "left", SCR_HEIGHT-50, 1.0f, glm::vec3(1.0, 1.0f, 1.0f));
         }else{
-            if(points == 1000){ // all coins and powerups are collected, you win
+            if(mazeClass.remainingPickups() == 0){ // all coins and powerups are collected, you win
                 renderText(textShader, "CONGRATS", "center", int(SCR_HEIGHT/1.8), 2.0f, glm::vec3(1.0, 1.0f, 1.0f));
                 renderText(textShader, "YOU WON!", "center", int(SCR_HEIGHT/2.5), 1.5f, glm::vec3(1.0, 1.0f, 1.0f));
 
@@ -474,16 +559,75 @@ int main()
     return 0;
 }
 
+// the ghosts of a generated maze start in the corners: blinky top left, pinky bottom right, inky top right, clyde bottom left
+vector<int> cornerCells() {
+    return {0, cols*rows - 1, cols - 1, (rows - 1)*cols};
+}
+
+// one line of topology per maze for count mazes of the command line's size and generator, from mazeSeed on
+// returns false if a maze isn't connected, so level checks can run it on many seeds and look at the exit code
+bool printMazeStats(int count) {
+    bool connected = true;
+    printf("%-20s %10s %10s %8s %10s %10s %10s %10s %12s %10s\n", "seed", "cells", "components", "loops", "dead ends",
+           "chains", "longest", "junctions", "articulation", "bridges");
+    // the topology is only built here, one object is rebuilt for every maze so its search memory is reused
+    MazeTopology topology;
+    for (int i = 0; i < count; i++) {
+        Maze stats(rows, cols, mazeSeed + i, mazeGenerator);
+        stats.generateMaze();
+        topology.build(stats.graph);
+        printf("%-20llu %10d %10d %8lld %10d %10zu %10d %10zu %12d %10lld\n", (unsigned long long)(mazeSeed + i), topology.getV(),
+               topology.getComponents(), topology.getLoops(), topology.getDeadEnds(), topology.getChains().size(),
+               topology.getLongestChain(), topology.getJunctions().size(), topology.getArticulationPoints(), topology.getBridges());
+        if (topology.getComponents() != 1) {
+            std::cout << "ERROR::MAZE: Maze with seed " << mazeSeed + i << " isn't connected" << std::endl;
+            connected = false;
+        }
+    }
+    return connected;
+}
+
+// ghost position of a spawn cell
+glm::vec3 spawnPosition(int ghost) {
+    return glm::vec3(ghostSpawns[ghost] % cols, 0.0f, ghostSpawns[ghost] / cols);
+}
+
 void startGame(){
-    mazeClass = Maze();
-    mazeClass.generateMaze();
+    // the ghosts' waiting requests are dropped, and searches still running on the old maze have to finish before it is replaced
+    blinkyGhost.cancelSearch();
+    pinkyGhost.cancelSearch();
+    inkyGhost.cancelSearch();
+    clydeGhost.cancelSearch();
+    navigation.stopSearches();
+    // a level file is mapped and its cells copied into the maze, every round starts the level again
+    LevelFile level;
+    if (levelPath != nullptr && level.open(levelPath) && level.getRows() >= minMazeSize && level.getCols() >= minMazeSize
+        && level.getGhostCount() >= 4) {
+        mazeClass = Maze(level);
+        setMazeSize(level.getRows(), level.getCols());
+        ghostSpawns.assign(4, 0);
+        for (int i = 0; i < 4; i++)
+            ghostSpawns[i] = level.getGhostSpawn(i);
+    } else {
+        if (levelPath != nullptr) {
+            std::cout << "ERROR::LEVEL: Failed to load " << levelPath << ", generating mazes instead" << std::endl;
+            levelPath = nullptr;
+        }
+        // the seed is printed so a maze can be played again by passing it on the command line
+        mazeClass = Maze(rows, cols, mazeSeed, mazeGenerator);
+        mazeClass.generateMaze();
+        std::cout << "maze seed: " << mazeSeed << std::endl;
+        mazeSeed = Random::randomSeed();
+        ghostSpawns = cornerCells();
+    }
+    navigation.build(mazeClass.graph);
     GAMEOVER = false;
     points = 0;
 
-    blinkyGhost = Ghost(glm::vec3(0.0f,0.0f,0.0f));
-    pinkyGhost = Ghost(glm::vec3(cols-1,0.0f,rows-1));
-    inkyGhost = Ghost(glm::vec3(cols-1,0.0f,0.0f));
-    clydeGhost = Ghost(glm::vec3(0.0f,0.0f,rows-1));
+    blinkyGhost = Ghost(spawnPosition(0), navigation);
+    pinkyGhost = Ghost(spawnPosition(1), navigation);
+    inkyGhost = Ghost(spawnPosition(2), navigation);
+    clydeGhost = Ghost(spawnPosition(3), navigation);
 
     cameraPos   = glm::vec3(cols/2+0.5f, 0.5f,  rows/2+0.5f);
 }
@@ -505,21 +649,20 @@ void ghostScared(Ghost &blinkyGhost, Ghost &pinkyGhost, Ghost &inkyGhost, Ghost
 }
 
 void pickupsCollision(ALuint coinSound, ALuint powerupSound) {
+    int row = (int)floor(cameraPos.z), col = (int)floor(cameraPos.x);
     // if the current maze cell has a coin add 10 points and play sound
-    if(maze[floor(cameraPos.z)][floor(cameraPos.x)].hasCoin){
-        maze[floor(cameraPos.z)][floor(cameraPos.x)].hasCoin = false;
+    if(mazeClass.coins.take(row, col)){
         points += 10;
         alSourcePlay(coinSound);
     }
     // if the current maze cell has a powerup add 10 points, start the timer (for scared ghosts) and play sound
-    if(maze[floor(cameraPos.z)][floor(cameraPos.x)].hasPowerup){
-        maze[floor(cameraPos.z)][floor(cameraPos.x)].hasPowerup = false;
+    if(mazeClass.powerups.take(row, col)){
         points += 10;
         timer = 5;
         alSourcePlay(powerupSound);
     }
-    // if 1000 points are collected, the game is over, the player won
-    if(points == 1000){
+    // if all coins and powerups are collected the game is over, the player won
+    if(mazeClass.remainingPickups() == 0){
         GAMEOVER = true;
     }
 }
@@ -528,7 +671,8 @@ void checkGhostCollision(Ghost &ghost, const glm::vec3 &resetPosition) {
     // check if a ghost is at the same spot as pacman
     if (getDistance(cameraPos, ghost.position) <= 0.5f) {
         if (ghost.isScared) {
-            ghost = Ghost(resetPosition);
+            ghost.cancelSearch();
+            ghost = Ghost(resetPosition, navigation);
         } else {
             GAMEOVER = true; // if not scared, the game is over, the player lost
         }
@@ -536,10 +680,10 @@ void checkGhostCollision(Ghost &ghost, const glm::vec3 &resetPosition) {
 }
 
 void ghostCollision(Ghost &blinkyGhost, Ghost &pinkyGhost, Ghost &inkyGhost, Ghost &clydeGhost) {
-    checkGhostCollision(blinkyGhost, glm::vec3(0.0f, 0.0f, 0.0f));
-    checkGhostCollision(pinkyGhost, glm::vec3(cols - 1, 0.0f, rows - 1));
-    checkGhostCollision(inkyGhost, glm::vec3(cols - 1, 0.0f, 0.0f));
-    checkGhostCollision(clydeGhost, glm::vec3(0.0f, 0.0f, rows - 1));
+    checkGhostCollision(blinkyGhost, spawnPosition(0));
+    checkGhostCollision(pinkyGhost, spawnPosition(1));
+    checkGhostCollision(inkyGhost, spawnPosition(2));
+    checkGhostCollision(clydeGhost, spawnPosition(3));
 }
 
 float getDistance(glm::vec3 pos1, glm::vec3 pos2){
@@ -547,26 +691,32 @@ float getDistance(glm::vec3 pos1, glm::vec3 pos2){
     return sqrt(pow(pos1.x-(pos2.x + 0.5f),2) + pow(pos1.z-(pos2.z + 0.5f),2));
 }
 
+// cells within drawDistance of the camera, as [rowFrom, rowTo) and [colFrom, colTo)
+void getDrawRange(int &rowFrom, int &rowTo, int &colFrom, int &colTo) {
+    rowFrom = std::max(0, (int)cameraPos.z - drawDistance);
+    rowTo = std::min(rows, (int)cameraPos.z + drawDistance + 1);
+    colFrom = std::max(0, (int)cameraPos.x - drawDistance);
+    colTo = std::min(cols, (int)cameraPos.x + drawDistance + 1);
+}
+
 void loadCoinsAndPowerups(glm::mat4 &model, Shader &shader, Model &coin, Model &powerup) {
-   // iterate through maze cells, check if the current cell has a coin or powerup, position, scale and draw it
-    for(int i=0; i < rows; i++){
-        for(int j=0;j<cols;j++){
-            if(maze[i][j].hasCoin){
-                model = glm::mat4(1.0f);
-                model = glm::translate(model, glm::vec3( j + 0.5f, 0.1f, i + 0.5f));
-                model = glm::scale(model, glm::vec3( 0.08f, 0.08f, 0.08f));
-                shader.setMat4("model", model);
-                coin.Draw(shader);
-            }
-            if(maze[i][j].hasPowerup){
-                model = glm::mat4(1.0f);
-                model = glm::translate(model, glm::vec3( j + 0.5f, 0.1f, i + 0.5f));
-                model = glm::scale(model, glm::vec3( 0.08f, 0.08f, 0.08f));
-                shader.setMat4("model", model);
-                powerup.Draw(shader);
-            }
-        }
-    }
+    int rowFrom, rowTo, colFrom, colTo;
+    getDrawRange(rowFrom, rowTo, colFrom, colTo);
+    // only the cells that still have a coin or powerup are visited, position, scale and draw it
+    mazeClass.coins.forEach(rowFrom, rowTo, colFrom, colTo, [&](int i, int j) {
+        model = glm::mat4(1.0f);
+        model = glm::translate(model, glm::vec3( j + 0.5f, 0.1f, i + 0.5f));
+        model = glm::scale(model, glm::vec3( 0.08f, 0.08f, 0.08f));
+        shader.setMat4("model", model);
+        coin.Draw(shader);
+    });
+    mazeClass.powerups.forEach(rowFrom, rowTo, colFrom, colTo, [&](int i, int j) {
+        model = glm::mat4(1.0f);
+        model = glm::translate(model, glm::vec3( j + 0.5f, 0.1f, i + 0.5f));
+        model = glm::scale(model, glm::vec3( 0.08f, 0.08f, 0.08f));
+        shader.setMat4("model", model);
+        powerup.Draw(shader);
+    });
 }
 
 void loadGhost(Ghost &ghost, Model &ghostModel, Model &scaredModel, Shader &shader) {
@@ -595,12 +745,14 @@ void loadGhosts(Ghost &blinkyGhost, Ghost &pinkyGhost, Ghost &inkyGhost, Ghost &
 
 void loadWalls(glm::mat4 &model, Shader &shader, Model &wall) {
     float scale = 0.132f;
+    int rowFrom, rowTo, colFrom, colTo;
+    getDrawRange(rowFrom, rowTo, colFrom, colTo);
 
     // iterate through each cell in the maze
-    for(int i=0;i<rows;i++){
-        for(int j=0;j<cols;j++){
+    for(int i=rowFrom;i<rowTo;i++){
+        for(int j=colFrom;j<colTo;j++){
             // draw left wall for each cell if wall exists
-            if(maze[i][j].wallLeft){
+            if(maze[i][j].wallLeft()){
                 model = glm::mat4(1.0f);
                 model = glm::translate(model, glm::vec3(j, 0.05f, (float)(i)+0.5f));
                 model = glm::scale(model, glm::vec3( scale, scale, scale));
@@ -608,7 +760,7 @@ void loadWalls(glm::mat4 &model, Shader &shader, Model &wall) {
                 wall.Draw(shader);
             }
             // draw top wall for each cell if wall exists
-            if(maze[i][j].wallUp){
+            if(maze[i][j].wallUp()){
                 model = glm::mat4(1.0f);
                 model = glm::translate(model, glm::vec3((float)(j)+0.5f, 0.05f, i));
                 model = glm::rotate(model, glm::radians(90.0f), glm::vec3(0, 1.0f, 0));
@@ -619,15 +771,15 @@ void loadWalls(glm::mat4 &model, Shader &shader, Model &wall) {
         }
     }
     // for each cell in the last column, draw right wall
-    for(int j=0;j<rows;j++){
+    for(int j=rowFrom;j<rowTo;j++){
         model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(rows, 0.05f, (float)(j)+0.5f));
+        model = glm::translate(model, glm::vec3(cols, 0.05f, (float)(j)+0.5f));
         model = glm::scale(model, glm::vec3( scale, scale, scale));
         shader.setMat4("model", model);
         wall.Draw(shader);
     }
     // for each cell in the last row, draw bottom wall
-    for(int j=0;j<cols;j++){
+    for(int j=colFrom;j<colTo;j++){
         model = glm::mat4(1.0f);
         model = glm::translate(model, glm::vec3((float)(j)+0.5f, 0.05f, rows));
         model = glm::rotate(model, glm::radians(90.0f), glm::vec3(0, 1.0f, 0));
@@ -794,13 +946,14 @@ void processInput(GLFWwindow *window)
     }
 
     // wall collisions to prevent the camera from moving through walls
-    if(maze[floor(cameraPos.z)][floor(cameraPos.x)].wallUp && distance(cameraPos.z,glm::floor(cameraPos.z)) <= wallSize)
+    Cell &cell = maze[(int)floor(cameraPos.z)][(int)floor(cameraPos.x)];
+    if(cell.wallUp() && distance(cameraPos.z,glm::floor(cameraPos.z)) <= wallSize)
         cameraPos.z = glm::floor(cameraPos.z)+wallSize;
-    if(maze[floor(cameraPos.z)][floor(cameraPos.x)].wallDown && distance(cameraPos.z,glm::floor(cameraPos.z)+1.0f) <= wallSize)
+    if(cell.wallDown() && distance(cameraPos.z,glm::floor(cameraPos.z)+1.0f) <= wallSize)
         cameraPos.z = glm::floor(cameraPos.z)+1.0f-wallSize;
-    if(maze[floor(cameraPos.z)][floor(cameraPos.x)].wallLeft && distance(cameraPos.x,glm::floor(cameraPos.x)) <= wallSize)
+    if(cell.wallLeft() && distance(cameraPos.x,glm::floor(cameraPos.x)) <= wallSize)
         cameraPos.x = glm::floor(cameraPos.x)+wallSize;
-    if(maze[floor(cameraPos.z)][floor(cameraPos.x)].wallRight && distance(cameraPos.x,glm::floor(cameraPos.x)+1.0f) <= wallSize)
+    if(cell.wallRight() && distance(cameraPos.x,glm::floor(cameraPos.x)+1.0f) <= wallSize)
         cameraPos.x = glm::floor(cameraPos.x)+1.0f-wallSize;
 }
 